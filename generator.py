@@ -24,7 +24,7 @@ def include(header, incs, root, included):
 
 def main():
 	header = open("temp", "w")
-	included, incs = include(header, [], "sql/schema.hpp", [])
+	included, incs = include(header, [], "sql/schema.hpp", ["#include \"sql/schema.hpp\"\n"])
 	included, incs = include(header, incs, "sql/query.hpp", included)
 	header.close()
 	header = open("single-header/sql.hpp", "w")
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "ra/operation.hpp"
+
+#include "sql/row.hpp"
+
+namespace ra
+{
+
+	namespace
+	{
+
+		// type keying the groups of a GROUP BY on the Keys columns, a single column keys them by its value
+		template <typename Keys>
+		struct group_key
+		{
+			using type = Keys;
+		};
+
+		template <typename Col>
+		struct group_key<sql::row<Col, sql::void_row>>
+		{
+			using type = typename Col::type;
+		};
+
+	} // namespace
+
+	// base of the nodes grouping their input rows on the Keys columns, the Aggregates fold the rows of
+	//	a group into its state and compute the Output columns from it
+	template <typename Output, typename Keys, typename Aggregates, typename Input>
+	class aggregation;
+
+	template <typename Output, typename Keys, typename... Aggregates, typename Input>
+	class aggregation<Output, Keys, std::tuple<Aggregates...>, Input> : public ra::unary<Input>
+	{
+	protected:
+		using input_type = typename ra::unary<Input>::input_type;
+		using key_type = typename group_key<Keys>::type;
+		using state_type = std::tuple<typename Aggregates::state...>;
+
+	public:
+		using output_type = Output;
+
+	protected:
+		// key of the group a row belongs to, a single grouped column is read in place
+		static inline decltype(auto) key(input_type const& row)
+		{
+			if constexpr (Keys::depth == 1)
+			{
+				return sql::get<Keys::column::name>(row);
+			}
+			else
+			{
+				Keys keys{};
+				copy<Keys>(keys, row);
+
+				return keys;
+			}
+		}
+
+		static inline void init(state_type& state, input_type const& row)
+		{
+			init(state, row, std::index_sequence_for<Aggregates...>{});
+		}
+
+		static inline void update(state_type& state, input_type const& row)
+		{
+			update(state, row, std::index_sequence_for<Aggregates...>{});
+		}
+
+		static inline void emit(output_type& dest, state_type const& state)
+		{
+			emit<0>(dest, state);
+		}
+
+	private:
+		template <typename Dest>
+		static inline void copy(Dest& dest, input_type const& src)
+		{
+			if constexpr (Dest::depth != 0)
+			{
+				dest.head() = sql::get<Dest::column::name>(src);
+				copy<typename Dest::next>(dest.tail(), src);
+			}
+		}
+
+		template <std::size_t... Ids>
+		static inline void init(state_type& state, input_type const& row, std::index_sequence<Ids...>)
+		{
+			(Aggregates::init(std::get<Ids>(state), row), ...);
+		}
+
+		template <std::size_t... Ids>
+		static inline void update(state_type& state, input_type const& row, std::index_sequence<Ids...>)
+		{
+			(Aggregates::update(std::get<Ids>(state), row), ...);
+		}
+
+		template <std::size_t Id, typename Dest>
+		static inline void emit(Dest& dest, state_type const& state)
+		{
+			if constexpr (Dest::depth != 0)
+			{
+				dest.head() = std::tuple_element_t<Id, std::tuple<Aggregates...>>::result(std::get<Id>(state));
+				emit<Id + 1>(dest.tail(), state);
+			}
+		}
+	};
+
+} // namespace ra
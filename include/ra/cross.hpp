@@ -1,33 +1,260 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
 #include "ra/join.hpp"
 #include "ra/relation.hpp"
+#include "ra/selection.hpp"
 
 namespace ra
 {
 
-	template <typename LeftInput, typename RightInput>
-	class cross : public ra::join<LeftInput, RightInput>
+	namespace
 	{
-		using join_type = ra::join<LeftInput, RightInput>;
+
+		// scans of row wise schemas hand out pointers to rows already in memory, other inputs are
+		//	filtered, projected, or loaded again on every rescan
+		template <typename Input>
+		struct resident : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct resident<ra::relation<Schema, Id, Columns>> : std::bool_constant<!Schema::columnar>
+		{};
+
+		// inputs whose row pointers stay valid until they are seeded again, selections forward their input's rows
+		template <typename Input>
+		struct stable : resident<Input>
+		{};
+
+		template <typename Predicate, typename Input>
+		struct stable<ra::selection<Predicate, Input>> : stable<Input>
+		{};
+
+	} // namespace
+
+	// block nested loop cross product, each block of Block left rows is paired with every block of Block right
+	//	rows so the right input is rescanned once per left block instead of once per left row, right inputs
+	//	which are not resident are drained once per seed and their rows are rescanned instead
+	template <typename LeftInput, typename RightInput,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>,
+		std::size_t Block = 64>
+	class cross : public ra::join<LeftInput, RightInput, Left, Right>
+	{
+		using join_type = ra::join<LeftInput, RightInput, Left, Right>;
+		using left_type = typename join_type::left_type;
+		using right_input_type = typename join_type::right_input_type;
+
+		static constexpr bool materialize{ !resident<RightInput>::value };
+		static constexpr bool copy{ materialize && !stable<RightInput>::value };
+
+		static_assert(Block > 0, "Cross join blocks hold at least one row.");
 	public:
 		using output_type = join_type::output_type;
 
-		static auto&& next()
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+
+			if constexpr (materialize)
+			{
+				drain();
+			}
+
+			restart();
+		}
+
+		void reset()
+		{
+			join_type::reset();
+			restart();
+		}
+
+		output_type const* next()
+		{
+			if (j_ == right_size_ && !forward())
+			{
+				return nullptr;
+			}
+
+			// the left columns only change once every right row of the block was paired with them
+			if (j_ == 0)
+			{
+				recr_copy(row_, block_[i_]);
+			}
+
+			join_type::copy_right(row_, *batch_[j_++]);
+
+			return &row_;
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			while (size < rows.size())
+			{
+				if (j_ == right_size_ && !forward())
+				{
+					break;
+				}
+
+				for (; j_ < right_size_ && size < rows.size(); ++j_, ++size)
+				{
+					recr_copy(buffer_[size], block_[i_]);
+					join_type::copy_right(buffer_[size], *batch_[j_]);
+					rows[size] = &buffer_[size];
+				}
+			}
+
+			return size;
+		}
+
+	private:
+		// empties both blocks so the first pair loads them
+		inline void restart() noexcept
+		{
+			left_size_ = 0;
+			right_size_ = 0;
+			i_ = 0;
+			j_ = 0;
+			offset_ = 0;
+		}
+
+		// moves to the next left row of the block, then to the next right block, then to the next left block
+		//	over a rescanned right input, false once the left input is exhausted
+		bool forward()
 		{
-			try
+			j_ = 0;
+
+			if (++i_ < left_size_)
+			{
+				return true;
+			}
+
+			i_ = 0;
+
+			if (left_size_ != 0 && fetch())
+			{
+				return true;
+			}
+
+			rewind();
+
+			if (load() && fetch())
+			{
+				return true;
+			}
+
+			left_size_ = 0;
+
+			return false;
+		}
+
+		// copies up to Block left rows out of the output row, false when the left input is exhausted
+		bool load()
+		{
+			if (block_.size() < Block)
+			{
+				block_.resize(Block);
+			}
+
+			for (left_size_ = 0; this->active_ && left_size_ < Block; this->advance())
+			{
+				fold<sql::void_row, left_type>(block_[left_size_++], this->output_row_);
+			}
+
+			return left_size_ != 0;
+		}
+
+		// points at the next block of right rows, streamed rows stay valid until the next batch is requested
+		bool fetch()
+		{
+			if constexpr (materialize)
+			{
+				right_size_ = std::min(Block, inputs_.size() - offset_);
+				batch_ = inputs_.data() + offset_;
+				offset_ += right_size_;
+			}
+			else
+			{
+				if (inputs_.size() < Block)
+				{
+					inputs_.resize(Block);
+				}
+
+				right_size_ = this->right_.next_batch(std::span{ inputs_.data(), Block });
+				batch_ = inputs_.data();
+			}
+
+			return right_size_ != 0;
+		}
+
+		// collects every right row, rows which do not outlive the next call to the right input are copied first
+		void drain()
+		{
+			inputs_.clear();
+
+			if constexpr (copy)
 			{
-				copy(join_type::output_row, RightInput::next());
+				copies_.clear();
+
+				for (auto const* row{ this->right_.next() }; row != nullptr; row = this->right_.next())
+				{
+					copies_.push_back(*row);
+				}
+
+				for (auto const& row : copies_)
+				{
+					inputs_.push_back(&row);
+				}
 			}
-			catch(ra::data_end const& e)
+			else
 			{
-				copy(join_type::output_row, LeftInput::next());
-				RightInput::reset();
-				copy(join_type::output_row, RightInput::next());
+				for (auto const* row{ this->right_.next() }; row != nullptr; row = this->right_.next())
+				{
+					inputs_.push_back(row);
+				}
 			}
+		}
 
-			return std::move(join_type::output_row);
+		// starts the right rows over for the next left block
+		inline void rewind()
+		{
+			if constexpr (materialize)
+			{
+				offset_ = 0;
+			}
+			else
+			{
+				this->right_.reset();
+			}
 		}
+
+		// the output row holds the left row after the block, so single rows are built apart from it
+		output_type row_{};
+		std::vector<left_type> block_{};
+		std::vector<right_input_type const*> inputs_{};
+		std::conditional_t<copy, std::vector<right_input_type>, sql::void_row> copies_{};
+		right_input_type const* const* batch_{};
+		std::vector<output_type> buffer_{};
+		std::size_t left_size_{};
+		std::size_t right_size_{};
+		std::size_t i_{};
+		std::size_t j_{};
+		std::size_t offset_{};
 	};
 
 } // namespace ra
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "ra/aggregation.hpp"
+#include "ra/hash.hpp"
+
+namespace ra
+{
+
+	// hash aggregation grouping the input rows on their Keys columns, the Aggregates compute the Output
+	//	columns of each group, the input is drained into one state per group when the node is seeded,
+	//	without Keys every row belongs to the one group which is output even when the input is empty
+	template <typename Output, typename Keys, typename Aggregates, typename Input>
+	class group : public ra::aggregation<Output, Keys, Aggregates, Input>
+	{
+		using base_type = ra::aggregation<Output, Keys, Aggregates, Input>;
+		using input_type = typename base_type::input_type;
+		using key_type = typename base_type::key_type;
+		using state_type = typename base_type::state_type;
+
+		static constexpr std::size_t batch_size{ 1024 };
+	public:
+		using output_type = Output;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			this->input_.seed(rs...);
+			index_ = {};
+			states_.clear();
+			curr_ = 0;
+
+			if constexpr (Keys::depth == 0)
+			{
+				states_.emplace_back();
+			}
+
+			std::vector<input_type const*> rows(batch_size);
+
+			for (auto count{ this->input_.next_batch(std::span{ rows }) }; count != 0; count = this->input_.next_batch(std::span{ rows }))
+			{
+				for (std::size_t i{}; i < count; ++i)
+				{
+					accumulate(*rows[i]);
+				}
+			}
+		}
+
+		// replays the groups, the input is only drained again when the node is seeded
+		inline void reset() noexcept
+		{
+			curr_ = 0;
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return states_.size();
+		}
+
+		// groups are output in the order their first rows were read
+		output_type const* next()
+		{
+			if (curr_ < states_.size())
+			{
+				base_type::emit(output_row_, states_[curr_++]);
+
+				return &output_row_;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			std::size_t size{};
+
+			for (; size < rows.size() && curr_ < states_.size(); ++size, ++curr_)
+			{
+				base_type::emit(buffer_[size], states_[curr_]);
+				rows[size] = &buffer_[size];
+			}
+
+			return size;
+		}
+
+	private:
+		inline void accumulate(input_type const& row)
+		{
+			if constexpr (Keys::depth == 0)
+			{
+				base_type::update(states_.front(), row);
+			}
+			else
+			{
+				auto const id{ index_.insert(base_type::key(row)) };
+
+				if (id > states_.size())
+				{
+					base_type::init(states_.emplace_back(), row);
+				}
+				else
+				{
+					base_type::update(states_[id - 1], row);
+				}
+			}
+		}
+
+		ra::key_index<key_type> index_{};
+		std::vector<state_type> states_{};
+		std::size_t curr_{};
+		output_type output_row_{};
+		std::vector<output_type> buffer_{};
+	};
+
+} // namespace ra
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ra
+{
+
+	// open addressing set which numbers its distinct keys from one in insertion order, zero marks an absent key
+	template <typename Key, typename Hash = std::hash<Key>>
+	class key_index
+	{
+	public:
+		// id of key, which is numbered after the keys inserted before it when it is not present
+		std::size_t insert(Key const& key)
+		{
+			auto const hash{ Hash{}(key) };
+			auto id{ lookup(key, hash) };
+
+			if (id == 0)
+			{
+				if ((keys_.size() + 1) * 2 > slots_.size())
+				{
+					grow();
+				}
+
+				keys_.push_back(key);
+				id = keys_.size();
+				place(hash, id);
+			}
+
+			return id;
+		}
+
+		inline std::size_t find(Key const& key) const
+		{
+			return lookup(key, Hash{}(key));
+		}
+
+		// keys in the order they were numbered, the key of id is at id - 1
+		inline std::span<Key const> keys() const noexcept
+		{
+			return keys_;
+		}
+
+		inline bool empty() const noexcept
+		{
+			return keys_.empty();
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return keys_.size();
+		}
+
+	private:
+		struct slot
+		{
+			std::size_t hash;
+			std::size_t id;
+		};
+
+		// fibonacci hashing spreads weak hashes (like identity hashes of integers) over the slots
+		inline std::size_t home(std::size_t hash) const noexcept
+		{
+			return (hash * 0x9E3779B97F4A7C15ull) >> shift_;
+		}
+
+		std::size_t lookup(Key const& key, std::size_t hash) const
+		{
+			if (slots_.empty())
+			{
+				return 0;
+			}
+
+			auto const mask{ slots_.size() - 1 };
+
+			for (auto i{ home(hash) }; slots_[i].id != 0; i = (i + 1) & mask)
+			{
+				if (slots_[i].hash == hash && keys_[slots_[i].id - 1] == key)
+				{
+					return slots_[i].id;
+				}
+			}
+
+			return 0;
+		}
+
+		void place(std::size_t hash, std::size_t id) noexcept
+		{
+			auto const mask{ slots_.size() - 1 };
+			auto i{ home(hash) };
+
+			while (slots_[i].id != 0)
+			{
+				i = (i + 1) & mask;
+			}
+
+			slots_[i] = slot{ hash, id };
+		}
+
+		// doubles the slot array keeping the load factor at or below one half
+		void grow()
+		{
+			auto old{ std::move(slots_) };
+			slots_ = std::vector<slot>(old.empty() ? 16 : old.size() * 2, slot{ 0, 0 });
+			shift_ = sizeof(std::size_t) * 8;
+
+			for (auto size{ slots_.size() }; size > 1; size >>= 1)
+			{
+				--shift_;
+			}
+
+			for (auto const& s : old)
+			{
+				if (s.id != 0)
+				{
+					place(s.hash, s.id);
+				}
+			}
+		}
+
+		std::vector<slot> slots_{};
+		std::vector<Key> keys_{};
+		std::size_t shift_{};
+	};
+
+	// open addressing multimap which is built once and then probed, the values of each key are
+	//	stored contiguously in insertion order and probing never inserts
+	template <typename Key, typename Value, typename Hash = std::hash<Key>>
+	class hash_table
+	{
+	public:
+		// stages a default constructed value under key, staged values are found once build is called
+		Value& emplace(Key const& key)
+		{
+			auto const id{ index_.insert(key) };
+
+			if (id == offsets_.size())
+			{
+				offsets_.push_back(0);
+			}
+
+			++offsets_[id];
+			staged_.emplace_back(id, Value{});
+
+			return staged_.back().second;
+		}
+
+		// lays the staged values out grouped by key
+		void build()
+		{
+			for (std::size_t id{ 1 }; id < offsets_.size(); ++id)
+			{
+				offsets_[id] += offsets_[id - 1];
+			}
+
+			std::vector<std::size_t> cursor(offsets_.begin(), offsets_.end() - 1);
+			values_.resize(staged_.size());
+
+			for (auto& [id, value] : staged_)
+			{
+				values_[cursor[id - 1]++] = std::move(value);
+			}
+
+			staged_ = {};
+		}
+
+		// values stored under key, empty when the key is not present
+		std::span<Value const> find(Key const& key) const
+		{
+			auto const id{ index_.find(key) };
+
+			if (id == 0)
+			{
+				return {};
+			}
+			else
+			{
+				return { values_.data() + offsets_[id - 1], offsets_[id] - offsets_[id - 1] };
+			}
+		}
+
+		// every value in the table, the values of a key are a sub span of these
+		inline std::span<Value const> values() const noexcept
+		{
+			return values_;
+		}
+
+		inline bool empty() const noexcept
+		{
+			return index_.empty();
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return values_.size();
+		}
+
+	private:
+		ra::key_index<Key, Hash> index_{};
+		std::vector<std::size_t> offsets_{ 0 };
+		std::vector<Value> values_{};
+		std::vector<std::pair<std::size_t, Value>> staged_{};
+	};
+
+	// the last table built for Owner, shared by every node of that type while the generation of the rows it
+	//	was built from is unchanged, build fills a new table once the generation moves on
+	template <typename Owner, typename Table>
+	class shared_table
+	{
+	public:
+		template <typename Build>
+		static std::shared_ptr<Table const> fetch(std::size_t generation, Build&& build)
+		{
+			// untracked rows can change without notice, so their tables are never shared
+			if (generation == 0)
+			{
+				auto table{ std::make_shared<Table>() };
+				build(*table);
+
+				return table;
+			}
+
+			std::lock_guard<std::mutex> lock{ mutex_ };
+
+			if (table_ == nullptr || generation_ != generation)
+			{
+				auto table{ std::make_shared<Table>() };
+				build(*table);
+				table_ = std::move(table);
+				generation_ = generation;
+			}
+
+			return table_;
+		}
+
+	private:
+		static inline std::mutex mutex_{};
+		static inline std::shared_ptr<Table const> table_{};
+		static inline std::size_t generation_{};
+	};
+
+} // namespace ra
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "cexpr/string.hpp"
+
+#include "ra/join.hpp"
+#include "ra/relation.hpp"
+
+#include "sql/row.hpp"
+
+namespace ra
+{
+
+	// index nested loop join, the right input is narrowed to the rows matching each left row's key
+	//	through its schema index so no build side table is held
+	template <typename LeftInput, typename RightInput, cexpr::string LeftKey, cexpr::string RightKey,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>>
+	class indexed : public ra::join<LeftInput, RightInput, Left, Right>
+	{
+		using join_type = ra::join<LeftInput, RightInput, Left, Right>;
+
+		static_assert(sql::exists<LeftKey, typename join_type::left_type>(), "Left join key must be carried into the output row.");
+	public:
+		using output_type = join_type::output_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+			seek();
+		}
+
+		void reset()
+		{
+			join_type::reset();
+			seek();
+		}
+
+		output_type const* next()
+		{
+			while (this->active_)
+			{
+				auto const* row{ this->right_.next() };
+
+				if (row != nullptr)
+				{
+					join_type::copy_right(this->output_row_, *row);
+
+					return &this->output_row_;
+				}
+
+				this->advance();
+				seek();
+			}
+
+			return nullptr;
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+				inputs_.resize(rows.size());
+			}
+
+			while (this->active_ && size < rows.size())
+			{
+				auto const count{ this->right_.next_batch(std::span{ inputs_.data(), rows.size() - size }) };
+
+				if (count == 0)
+				{
+					this->advance();
+					seek();
+
+					continue;
+				}
+
+				for (std::size_t i{}; i < count; ++i, ++size)
+				{
+					buffer_[size] = this->output_row_;
+					join_type::copy_right(buffer_[size], *inputs_[i]);
+					rows[size] = &buffer_[size];
+				}
+			}
+
+			return size;
+		}
+
+	private:
+		// points the right input at the rows with the key of the current left row
+		inline void seek()
+		{
+			if (this->active_)
+			{
+				this->right_.template seek<RightKey>(sql::get<LeftKey>(this->output_row_));
+			}
+		}
+
+		std::vector<output_type> buffer_{};
+		std::vector<typename join_type::right_input_type const*> inputs_{};
+	};
+
+} // namespace ra
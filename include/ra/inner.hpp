@@ -0,0 +1,332 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "cexpr/string.hpp"
+
+#include "ra/hash.hpp"
+#include "ra/join.hpp"
+#include "ra/relation.hpp"
+
+#include "sql/predicate.hpp"
+#include "sql/row.hpp"
+
+namespace ra
+{
+
+	// hash equi join of the LeftKey column of the left input with the RightKey column of the right input,
+	//	Build chooses the input the hash table is built over and the other input is streamed over it
+	template <typename LeftInput, typename RightInput, cexpr::string LeftKey, cexpr::string RightKey,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>,
+		ra::side Build = ra::side::right>
+	class inner : public ra::join<LeftInput, RightInput, Left, Right>
+	{
+		using join_type = ra::join<LeftInput, RightInput, Left, Right>;
+		using left_type = typename join_type::left_type;
+		using right_type = typename join_type::right_type;
+		using left_key = std::remove_cvref_t<decltype(sql::get<LeftKey>(typename join_type::left_input_type{}))>;
+		using right_key = std::remove_cvref_t<decltype(sql::get<RightKey>(typename join_type::right_input_type{}))>;
+
+		// hash table built over the Side input and the cursor into its rows matching the current probe row, keyed on
+		//	the values of nullable keys since null keys match no row
+		template <ra::side Side>
+		struct cache
+		{
+			using key_type = typename sql::nullable_type<std::conditional_t<Side == ra::side::right, right_key, left_key>>::type::value_type;
+			using value_type = std::conditional_t<Side == ra::side::right, decltype(remainder<left_type, right_type>()), left_type>;
+			using table_type = ra::hash_table<key_type, value_type>;
+
+			std::shared_ptr<table_type const> table{};
+			value_type const* curr{};
+			value_type const* end{};
+		};
+
+		static_assert(sql::exists<LeftKey, left_type>(), "Left join key must be carried into the output row.");
+	public:
+		using output_type = join_type::output_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+
+			if constexpr (Build == ra::side::smaller)
+			{
+				// ties build over the right input so the left input keeps streaming in order
+				build_left_ = this->left_.size() < this->right_.size();
+
+				if (build_left_)
+				{
+					start<ra::side::left>();
+				}
+				else
+				{
+					start<ra::side::right>();
+				}
+			}
+			else
+			{
+				start<Build>();
+			}
+		}
+
+		void reset()
+		{
+			join_type::reset();
+
+			if constexpr (Build != ra::side::smaller)
+			{
+				match<Build>();
+			}
+			else if (build_left_)
+			{
+				match<ra::side::left>();
+			}
+			else
+			{
+				match<ra::side::right>();
+			}
+		}
+
+		output_type const* next()
+		{
+			if constexpr (Build != ra::side::smaller)
+			{
+				return step<Build>();
+			}
+			else if (build_left_)
+			{
+				return step<ra::side::left>();
+			}
+			else
+			{
+				return step<ra::side::right>();
+			}
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if constexpr (Build != ra::side::smaller)
+			{
+				return batch<Build>(rows);
+			}
+			else if (build_left_)
+			{
+				return batch<ra::side::left>(rows);
+			}
+			else
+			{
+				return batch<ra::side::right>(rows);
+			}
+		}
+
+	private:
+		template <ra::side Side>
+		inline cache<Side>& cached() noexcept
+		{
+			if constexpr (Side == ra::side::left)
+			{
+				return left_cache_;
+			}
+			else
+			{
+				return right_cache_;
+			}
+		}
+
+		// takes the hash table over the Side input, which is only built when no node of this type has
+		//	built one over the current generation of its rows, and points at the first matches
+		template <ra::side Side>
+		inline void start()
+		{
+			using table_type = typename cache<Side>::table_type;
+
+			auto const generation{ Side == ra::side::right ? this->right_.generation() : this->left_.generation() };
+
+			auto fill = [this](table_type& table)
+			{
+				build<Side>(table);
+			};
+
+			cached<Side>().table = ra::shared_table<cache<Side>, table_type>::fetch(generation, fill);
+
+			match<Side>();
+		}
+
+		template <ra::side Side>
+		inline output_type const* step()
+		{
+			auto& cache{ cached<Side>() };
+
+			while (cache.curr == cache.end)
+			{
+				if (!probe<Side>())
+				{
+					return nullptr;
+				}
+			}
+
+			place<Side>(this->output_row_, *cache.curr++);
+
+			return &this->output_row_;
+		}
+
+		template <ra::side Side>
+		std::size_t batch(std::span<output_type const*> rows)
+		{
+			auto& cache{ cached<Side>() };
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			while (size < rows.size())
+			{
+				if (cache.curr == cache.end)
+				{
+					if (!probe<Side>())
+					{
+						break;
+					}
+				}
+				else
+				{
+					buffer_[size] = this->output_row_;
+					place<Side>(buffer_[size], *cache.curr++);
+					rows[size] = &buffer_[size];
+					++size;
+				}
+			}
+
+			return size;
+		}
+
+		// drains the build input into the hash table, the left input arrives through the output row
+		template <ra::side Side>
+		void build(typename cache<Side>::table_type& table)
+		{
+			using value_type = typename cache<Side>::value_type;
+
+			if constexpr (Side == ra::side::right)
+			{
+				for (auto const* row{ this->right_.next() }; row != nullptr; row = this->right_.next())
+				{
+					if (auto const& key{ sql::get<RightKey>(*row) }; sql::known(key))
+					{
+						fold<sql::void_row, value_type>(table.emplace(sql::unwrap(key)), *row);
+					}
+				}
+
+				this->right_.reset();
+			}
+			else
+			{
+				for (bool row{ this->active_ }; row; row = this->advance())
+				{
+					if (auto const& key{ sql::get<LeftKey>(this->output_row_) }; sql::known(key))
+					{
+						fold<sql::void_row, value_type>(table.emplace(sql::unwrap(key)), this->output_row_);
+					}
+				}
+			}
+
+			table.build();
+		}
+
+		// points the cursor at the cached rows matching the current probe row
+		template <ra::side Side>
+		inline void match()
+		{
+			auto& cache{ cached<Side>() };
+
+			if constexpr (Side == ra::side::right)
+			{
+				if (this->active_ && sql::known(sql::get<LeftKey>(this->output_row_)))
+				{
+					auto const rows{ cache.table->find(sql::unwrap(sql::get<LeftKey>(this->output_row_))) };
+					cache.curr = rows.data();
+					cache.end = rows.data() + rows.size();
+				}
+				else
+				{
+					cache.curr = cache.end;
+				}
+			}
+			else
+			{
+				cache.curr = cache.end;
+			}
+		}
+
+		// moves to the next row of the streamed input, false once it is exhausted
+		template <ra::side Side>
+		inline bool probe()
+		{
+			if constexpr (Side == ra::side::right)
+			{
+				if (!this->advance())
+				{
+					return false;
+				}
+
+				match<Side>();
+			}
+			else
+			{
+				auto const* row{ this->right_.next() };
+
+				if (row == nullptr)
+				{
+					return false;
+				}
+
+				auto& cache{ cached<Side>() };
+
+				if (auto const& key{ sql::get<RightKey>(*row) }; sql::known(key))
+				{
+					auto const rows{ cache.table->find(sql::unwrap(key)) };
+					cache.curr = rows.data();
+					cache.end = rows.data() + rows.size();
+				}
+				else
+				{
+					cache.curr = cache.end;
+				}
+
+				if (cache.curr != cache.end)
+				{
+					join_type::copy_right(this->output_row_, *row);
+				}
+			}
+
+			return true;
+		}
+
+		// copies a cached row into its place in the output row
+		template <ra::side Side>
+		static inline void place(output_type& dest, typename cache<Side>::value_type const& src)
+		{
+			if constexpr (Side == ra::side::right)
+			{
+				copy_after<left_type>(dest, src);
+			}
+			else
+			{
+				recr_copy(dest, src);
+			}
+		}
+
+		std::conditional_t<Build == ra::side::right, sql::void_row, cache<ra::side::left>> left_cache_{};
+		std::conditional_t<Build == ra::side::left, sql::void_row, cache<ra::side::right>> right_cache_{};
+		std::vector<output_type> buffer_{};
+		bool build_left_{};
+	};
+
+} // namespace ra
@@ -4,6 +4,7 @@
 
 #include "ra/operation.hpp"
 
+#include "sql/column.hpp"
 #include "sql/row.hpp"
 
 namespace ra
@@ -27,10 +28,24 @@ namespace ra
 			}
 		}
 
+		// true when merge drops the leading column of Right in favour of the one of Left
+		template <typename Left, typename Right>
+		constexpr bool shared() noexcept
+		{
+			if constexpr (std::is_same_v<Left, sql::void_row> || std::is_same_v<Right, sql::void_row>)
+			{
+				return false;
+			}
+			else
+			{
+				return Left::column::name == Right::column::name;
+			}
+		}
+
 		template <typename Left, typename Right>
 		inline constexpr auto merge()
 		{
-			if constexpr (Left::column::name == Right::column::name)
+			if constexpr (shared<Left, Right>())
 			{
 				return recr_merge<Left, typename Right::next>();
 			}
@@ -40,6 +55,36 @@ namespace ra
 			}
 		}
 
+		// Row with every column nullable, the columns of the input an outer join pads with nulls
+		template <typename Row>
+		constexpr auto padded()
+		{
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return sql::void_row{};
+			}
+			else
+			{
+				using next = decltype(padded<typename Row::next>());
+
+				return sql::row<sql::nullable<typename Row::column>, next>{};
+			}
+		}
+
+		// columns of Right which merge places after the columns of Left
+		template <typename Left, typename Right>
+		constexpr auto remainder()
+		{
+			if constexpr (shared<Left, Right>())
+			{
+				return typename Right::next{};
+			}
+			else
+			{
+				return Right{};
+			}
+		}
+
 		template <typename Dest, typename Row>
 		constexpr void recr_copy(Dest& dest, Row const& src)
 		{
@@ -54,47 +99,107 @@ namespace ra
 			}
 		}
 
-		template <typename Dest, typename Row>
-		inline constexpr void copy(Dest& dest, Row const& src)
+		// copies src into dest starting one past the columns of Left
+		template <typename Left, typename Dest, typename Row>
+		constexpr void copy_after(Dest& dest, Row const& src)
 		{
-			if constexpr (Dest::column::name == Row::column::name)
+			if constexpr (std::is_same_v<Left, sql::void_row>)
 			{
 				recr_copy(dest, src);
 			}
 			else
 			{
-				copy(dest.tail(), src);
+				copy_after<typename Left::next>(dest.tail(), src);
+			}
+		}
+
+		// skips the columns of Skip in dest, then copies the columns of Cols from src by name
+		template <typename Skip, typename Cols, typename Dest, typename Row>
+		constexpr void fold(Dest& dest, Row const& src)
+		{
+			if constexpr (!std::is_same_v<Skip, sql::void_row>)
+			{
+				fold<typename Skip::next, Cols>(dest.tail(), src);
+			}
+			else if constexpr (std::is_same_v<Cols, sql::void_row>)
+			{
+				return;
+			}
+			else
+			{
+				dest.head() = sql::get<Cols::column::name>(src);
+				fold<sql::void_row, typename Cols::next>(dest.tail(), src);
 			}
 		}
 
 	} // namespace
 
-	template <typename LeftInput, typename RightInput>
+	// input of a hash join which its table is built over, smaller picks the input with fewer rows once seeded
+	enum class side
+	{
+		left,
+		right,
+		smaller
+	};
+
+	// inputs whose unmatched rows an outer join keeps
+	enum class keep
+	{
+		left,
+		right,
+		both
+	};
+
+	// Left and Right list the columns of each input carried into the output rows
+	template <typename LeftInput, typename RightInput, typename Left, typename Right>
 	class join : public ra::binary<LeftInput, RightInput>
 	{
 		using binary_type = ra::binary<LeftInput, RightInput>;
-		using left_type = typename binary_type::left_type;
-		using right_type = typename binary_type::right_type;
+	protected:
+		using left_input_type = typename binary_type::left_type;
+		using right_input_type = typename binary_type::right_type;
+		using left_type = Left;
+		using right_type = Right;
 	public:
 		using output_type = decltype(merge<left_type, right_type>());
 
 		template <typename... Inputs>
-		static inline void seed(Inputs const&... rs)
+		inline void seed(Inputs const&... rs)
 		{
 			binary_type::seed(rs...);
-			copy(output_row, LeftInput::next());
+			advance();
 		}
 
-		static inline void reset()
+		inline void reset()
 		{
 			binary_type::reset();
-			copy(output_row, LeftInput::next());
+			advance();
 		}
 
-		static output_type output_row;
-	};
+	protected:
+		// copies the next left row into the output row, false once the left input is exhausted
+		inline bool advance()
+		{
+			auto const* row{ this->left_.next() };
+
+			if (row != nullptr)
+			{
+				fold<sql::void_row, left_type>(output_row_, *row);
+			}
 
-	template <typename LeftInput, typename RightInput>
-	typename join<LeftInput, RightInput>::output_type join<LeftInput, RightInput>::output_row{};
+			active_ = row != nullptr;
+
+			return active_;
+		}
+
+		// right rows are placed after the left columns, less their leading column when merge dropped it
+		static inline void copy_right(output_type& dest, right_input_type const& src)
+		{
+			fold<left_type, decltype(remainder<left_type, right_type>())>(dest, src);
+		}
+
+		output_type output_row_{};
+		bool active_{};
+	};
 
 } // namespace ra
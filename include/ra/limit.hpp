@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#include "ra/operation.hpp"
+
+namespace ra
+{
+
+	// first Limit input rows after the first Offset, the input is no longer pulled once Limit rows were output
+	//	and is never seeded when Limit is zero, so nodes which do their work when seeded (like building a hash
+	//	table) skip it, Skip inputs output one row per row of a scan and jump past the Offset rows without reading them
+	template <std::size_t Limit, std::size_t Offset, bool Skip, typename Input>
+	class limit : public ra::unary<Input>
+	{
+		using input_type = typename ra::unary<Input>::input_type;
+	public:
+		using output_type = input_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			if constexpr (Limit != 0)
+			{
+				this->input_.seed(rs...);
+			}
+
+			count_ = 0;
+			skipped_ = false;
+		}
+
+		void reset()
+		{
+			if constexpr (Limit != 0)
+			{
+				this->input_.reset();
+			}
+
+			count_ = 0;
+			skipped_ = false;
+		}
+
+		// rows of the seeded input, an upper bound of the rows output
+		inline std::size_t size() const
+		{
+			if constexpr (Limit == 0)
+			{
+				return 0;
+			}
+			else
+			{
+				return std::min(Limit, this->input_.size());
+			}
+		}
+
+		// an unseeded input has no rows to track
+		inline std::size_t generation() const
+		{
+			if constexpr (Limit == 0)
+			{
+				return 0;
+			}
+			else
+			{
+				return this->input_.generation();
+			}
+		}
+
+		output_type const* next()
+		{
+			if (count_ == Limit || !skip())
+			{
+				return nullptr;
+			}
+
+			auto const* row{ this->input_.next() };
+
+			if (row != nullptr)
+			{
+				++count_;
+			}
+
+			return row;
+		}
+
+		// fills at most the rows left to output, so the input never produces rows past the limit
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (count_ == Limit || !skip())
+			{
+				return 0;
+			}
+
+			auto const size{ this->input_.next_batch(rows.first(std::min(rows.size(), Limit - count_))) };
+			count_ += size;
+
+			return size;
+		}
+
+	private:
+		// passes over the Offset rows before the first row output, false when the input ended among them
+		inline bool skip()
+		{
+			if constexpr (Offset != 0)
+			{
+				if (!skipped_)
+				{
+					std::size_t size{};
+
+					if constexpr (Skip)
+					{
+						size = this->input_.skip(Offset);
+					}
+					else
+					{
+						while (size < Offset && this->input_.next() != nullptr)
+						{
+							++size;
+						}
+					}
+
+					skipped_ = true;
+
+					if (size < Offset)
+					{
+						count_ = Limit;
+
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		std::size_t count_{};
+		bool skipped_{};
+	};
+
+} // namespace ra
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <type_traits>
 
 namespace ra
@@ -9,39 +10,63 @@ namespace ra
 	class unary
 	{
 	public:
-		using input_type = std::remove_cvref_t<decltype(Input::next())>;
+		using input_type = std::remove_cvref_t<typename Input::output_type>;
 
 		template <typename... Inputs>
-		static inline void seed(Inputs const&... rs)
+		inline void seed(Inputs const&... rs)
 		{
-			Input::seed(rs...);
+			input_.seed(rs...);
 		}
 
-		static inline void reset()
+		inline void reset()
 		{
-			Input::reset();
+			input_.reset();
 		}
+
+		// rows of the seeded input, an upper bound for nodes which filter their input
+		inline std::size_t size() const
+		{
+			return input_.size();
+		}
+
+		inline std::size_t generation() const
+		{
+			return input_.generation();
+		}
+
+	protected:
+		Input input_;
 	};
 
 	template <typename LeftInput, typename RightInput>
 	class binary
 	{
 	public:
-		using left_type = std::remove_cvref_t<decltype(LeftInput::next())>;
-		using right_type = std::remove_cvref_t<decltype(RightInput::next())>;
+		using left_type = std::remove_cvref_t<typename LeftInput::output_type>;
+		using right_type = std::remove_cvref_t<typename RightInput::output_type>;
 
 		template <typename... Inputs>
-		static inline void seed(Inputs const&... rs)
+		inline void seed(Inputs const&... rs)
 		{
-			LeftInput::seed(rs...);
-			RightInput::seed(rs...);
+			left_.seed(rs...);
+			right_.seed(rs...);
 		}
 
-		static inline void reset()
+		inline void reset()
 		{
-			LeftInput::reset();
-			RightInput::reset();
+			left_.reset();
+			right_.reset();
 		}
+
+		// joined rows are not tracked, so tables built over them are rebuilt on every seed
+		inline std::size_t generation() const noexcept
+		{
+			return 0;
+		}
+
+	protected:
+		LeftInput left_;
+		RightInput right_;
 	};
 
 } // namespace ra
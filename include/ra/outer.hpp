@@ -0,0 +1,301 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "cexpr/string.hpp"
+
+#include "ra/hash.hpp"
+#include "ra/join.hpp"
+#include "ra/relation.hpp"
+
+#include "sql/predicate.hpp"
+#include "sql/row.hpp"
+
+namespace ra
+{
+
+	// hash outer join of the LeftKey column of the left input with the RightKey column of the right input,
+	//	rows of the kept inputs without a match are emitted once with the columns of the other input null
+	template <typename LeftInput, typename RightInput, cexpr::string LeftKey, cexpr::string RightKey,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>,
+		ra::keep Keep = ra::keep::left>
+	class outer : public ra::join<LeftInput, RightInput,
+		std::conditional_t<Keep == ra::keep::left, Left, decltype(padded<Left>())>,
+		std::conditional_t<Keep == ra::keep::right, Right, decltype(padded<Right>())>>
+	{
+		using join_type = ra::join<LeftInput, RightInput,
+			std::conditional_t<Keep == ra::keep::left, Left, decltype(padded<Left>())>,
+			std::conditional_t<Keep == ra::keep::right, Right, decltype(padded<Right>())>>;
+		using left_type = typename join_type::left_type;
+		using right_type = typename join_type::right_type;
+
+		// right outer joins build over the left input so the right input streams in order
+		static constexpr bool build_left{ Keep == ra::keep::right };
+
+		using left_key = std::remove_cvref_t<decltype(sql::get<LeftKey>(typename join_type::left_input_type{}))>;
+		using right_key = std::remove_cvref_t<decltype(sql::get<RightKey>(typename join_type::right_input_type{}))>;
+		using key_type = std::conditional_t<build_left, left_key, right_key>;
+		using value_type = std::conditional_t<build_left, left_type, decltype(remainder<left_type, right_type>())>;
+		using table_type = ra::hash_table<key_type, value_type>;
+
+		static_assert(sql::exists<LeftKey, left_type>(), "Left join key must be carried into the output row.");
+	public:
+		using output_type = join_type::output_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+
+			// the hash table is only built when no node of this type has built one over the current
+			//	generation of the build input's rows
+			auto const generation{ build_left ? this->left_.generation() : this->right_.generation() };
+
+			auto fill = [this](table_type& table)
+			{
+				build(table);
+			};
+
+			row_cache_ = ra::shared_table<outer, table_type>::fetch(generation, fill);
+			restart();
+		}
+
+		void reset()
+		{
+			join_type::reset();
+			restart();
+		}
+
+		output_type const* next()
+		{
+			while (true)
+			{
+				if (curr_ != end_)
+				{
+					if constexpr (Keep == ra::keep::both)
+					{
+						seen_[curr_ - row_cache_->values().data()] = true;
+					}
+
+					place(this->output_row_, *curr_++);
+
+					return &this->output_row_;
+				}
+				else if (pad_)
+				{
+					pad_ = false;
+					place(this->output_row_, value_type{});
+
+					return &this->output_row_;
+				}
+				else if (!probe())
+				{
+					break;
+				}
+			}
+
+			if constexpr (Keep == ra::keep::both)
+			{
+				return unmatched();
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		// outer joins emit through next, batches are buffered copies of its rows
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			for (auto const* row{ size < rows.size() ? next() : nullptr }; row != nullptr; row = size < rows.size() ? next() : nullptr)
+			{
+				buffer_[size] = *row;
+				rows[size] = &buffer_[size];
+				++size;
+			}
+
+			return size;
+		}
+
+	private:
+		// drains the build input into the hash table, the left input arrives through the output row
+		void build(table_type& table)
+		{
+			if constexpr (build_left)
+			{
+				for (bool row{ this->active_ }; row; row = this->advance())
+				{
+					fold<sql::void_row, value_type>(table.emplace(current()), this->output_row_);
+				}
+			}
+			else
+			{
+				for (auto const* row{ this->right_.next() }; row != nullptr; row = this->right_.next())
+				{
+					fold<sql::void_row, value_type>(table.emplace(sql::get<RightKey>(*row)), *row);
+				}
+
+				this->right_.reset();
+			}
+
+			table.build();
+		}
+
+		// positions the node before its first output row
+		inline void restart()
+		{
+			if constexpr (Keep == ra::keep::both)
+			{
+				seen_.assign(row_cache_->size(), false);
+				index_ = 0;
+			}
+
+			if constexpr (build_left)
+			{
+				curr_ = end_;
+				pad_ = false;
+			}
+			else if (this->active_)
+			{
+				match(current());
+			}
+			else
+			{
+				curr_ = end_;
+				pad_ = false;
+			}
+		}
+
+		// points the cursor at the cached rows matching key, a probe row without any is padded, null keys match
+		//	no row but the null keys of the build input are kept so a full join emits their rows
+		template <typename Key>
+		inline void match(Key const& key)
+		{
+			if (sql::known(key))
+			{
+				auto const rows{ find(key) };
+				curr_ = rows.data();
+				end_ = rows.data() + rows.size();
+				pad_ = rows.empty();
+			}
+			else
+			{
+				curr_ = end_;
+				pad_ = true;
+			}
+		}
+
+		template <typename Key>
+		inline auto find(Key const& key) const
+		{
+			if constexpr (std::is_same_v<Key, key_type>)
+			{
+				return row_cache_->find(key);
+			}
+			else if constexpr (sql::nullable_type<key_type>::value)
+			{
+				return row_cache_->find(key_type{ key });
+			}
+			else
+			{
+				return row_cache_->find(sql::unwrap(key));
+			}
+		}
+
+		// moves to the next row of the streamed input, false once it is exhausted
+		inline bool probe()
+		{
+			if constexpr (build_left)
+			{
+				auto const* row{ this->right_.next() };
+
+				if (row == nullptr)
+				{
+					return false;
+				}
+
+				join_type::copy_right(this->output_row_, *row);
+				match(sql::get<RightKey>(*row));
+			}
+			else
+			{
+				if (!this->advance())
+				{
+					return false;
+				}
+
+				match(current());
+			}
+
+			return true;
+		}
+
+		// key of the left row in the output row, padded left columns are never null while reading the left input
+		//	unless the left input's key is itself nullable
+		inline left_key const& current() const noexcept
+		{
+			if constexpr (Keep == ra::keep::left || sql::nullable_type<left_key>::value)
+			{
+				return sql::get<LeftKey>(this->output_row_);
+			}
+			else
+			{
+				return *sql::get<LeftKey>(this->output_row_);
+			}
+		}
+
+		// right rows of a full join which matched no left row, emitted once the left input is exhausted
+		output_type const* unmatched()
+		{
+			auto const values{ row_cache_->values() };
+
+			while (index_ < values.size())
+			{
+				auto const i{ index_++ };
+
+				if (!seen_[i])
+				{
+					recr_copy(this->output_row_, left_type{});
+					place(this->output_row_, values[i]);
+
+					return &this->output_row_;
+				}
+			}
+
+			return nullptr;
+		}
+
+		// copies a cached row, or the nulls of a padded row, into its place in the output row
+		static inline void place(output_type& dest, value_type const& src)
+		{
+			if constexpr (build_left)
+			{
+				recr_copy(dest, src);
+			}
+			else
+			{
+				copy_after<left_type>(dest, src);
+			}
+		}
+
+		std::shared_ptr<table_type const> row_cache_{};
+		std::vector<output_type> buffer_{};
+		std::conditional_t<Keep == ra::keep::both, std::vector<bool>, sql::void_row> seen_{};
+		std::size_t index_{};
+		value_type const* curr_{};
+		value_type const* end_{};
+		bool pad_{};
+	};
+
+} // namespace ra
@@ -1,42 +1,197 @@
 #pragma once
 
-#include <exception>
+#include <algorithm>
+#include <iterator>
+#include <span>
 #include <type_traits>
+#include <vector>
+
+#include "cexpr/string.hpp"
+
+#include "sql/row.hpp"
 
 namespace ra
 {
 
-	struct data_end : std::exception
-	{};
+	// contiguous sub range of a schema's rows, seeds a relation with part of a table
+	template <typename Schema>
+	struct slice
+	{
+		Schema::const_iterator first;
+		Schema::const_iterator last;
+
+		inline Schema::const_iterator begin() const noexcept
+		{
+			return first;
+		}
+
+		inline Schema::const_iterator end() const noexcept
+		{
+			return last;
+		}
+	};
 
 	// Id template parameter allows unique ra::relation types to be instantiated from
 	//	a single sql::schema type (for queries referencing a schema multiple times).
-	template <typename Schema, std::size_t Id>
+	// Columns lists the columns a query reads, only those are loaded from column wise schemas.
+	template <typename Schema, std::size_t Id, typename Columns = Schema::row_type>
 	class relation
 	{
 	public:
-		using output_type = Schema::row_type&;
+		using output_type = Schema::row_type;
+
+		// nullptr signals the end of the data stream
+		inline output_type const* next() noexcept(!Schema::columnar)
+		{
+			if (curr_ != end_)
+			{
+				if constexpr (Schema::columnar)
+				{
+					curr_++.template load<Columns>(output_row_);
+
+					return &output_row_;
+				}
+				else
+				{
+					return &*curr_++;
+				}
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		// fills rows with pointers to up to rows.size() rows, zero signals the end of the data stream
+		inline std::size_t next_batch(std::span<output_type const*> rows) noexcept(!Schema::columnar)
+		{
+			std::size_t size{};
 
-		static auto& next()
+			if constexpr (Schema::columnar)
+			{
+				if (buffer_.size() < rows.size())
+				{
+					buffer_.resize(rows.size());
+				}
+
+				size = std::min<std::size_t>(rows.size(), end_ - curr_);
+				curr_.template load<Columns>(std::span{ buffer_.data(), size });
+				curr_ += size;
+
+				for (std::size_t i{}; i < size; ++i)
+				{
+					rows[i] = &buffer_[i];
+				}
+			}
+			else
+			{
+				for (; size < rows.size() && curr_ != end_; ++size, ++curr_)
+				{
+					rows[size] = &*curr_;
+				}
+			}
+
+			return size;
+		}
+
+		// advances past up to count rows without reading them, returns the number of rows skipped
+		inline std::size_t skip(std::size_t count) noexcept
 		{
-			if (curr != end)
+			std::size_t size{};
+
+			if constexpr (Schema::columnar || std::random_access_iterator<typename Schema::const_iterator>)
 			{
-				return *curr++;
+				size = std::min<std::size_t>(count, end_ - curr_);
+				curr_ += size;
 			}
 			else
 			{
-				throw ra::data_end{};
+				for (; size < count && curr_ != end_; ++curr_)
+				{
+					++size;
+				}
 			}
+
+			return size;
+		}
+
+		// late materialization for column wise schemas under a selection, the columns read by
+		//	Predicate are loaded for every row and the remaining columns only for qualifying rows
+		template <typename Predicate>
+		output_type const* next_where()
+		{
+			using keys = decltype(split<Predicate, true, Columns>());
+			using rest = decltype(split<Predicate, false, Columns>());
+
+			for (; curr_ != end_; ++curr_)
+			{
+				curr_.template load<keys>(output_row_);
+
+				if (Predicate::eval(output_row_))
+				{
+					curr_++.template load<rest>(output_row_);
+
+					return &output_row_;
+				}
+			}
+
+			return nullptr;
+		}
+
+		// batch of late materialized rows, a batch is only refilled once none of its rows qualified
+		template <typename Predicate>
+		std::size_t next_batch_where(std::span<output_type const*> rows)
+		{
+			using keys = decltype(split<Predicate, true, Columns>());
+			using rest = decltype(split<Predicate, false, Columns>());
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			std::size_t size{};
+
+			while (size == 0 && curr_ != end_)
+			{
+				auto const count{ std::min<std::size_t>(rows.size(), end_ - curr_) };
+				curr_.template load<keys>(std::span{ buffer_.data(), count });
+
+				for (std::size_t i{}; i < count; ++i)
+				{
+					if (Predicate::eval(buffer_[i]))
+					{
+						auto row{ curr_ };
+						row += i;
+						row.template load<rest>(buffer_[i]);
+						rows[size++] = &buffer_[i];
+					}
+				}
+
+				curr_ += count;
+			}
+
+			return size;
 		}
 		
 		template <typename Input, typename... Inputs>
-		static void seed(Input const& r, Inputs const&... rs) noexcept
+		void seed(Input const& r, Inputs const&... rs) noexcept
 		{
-			if constexpr (std::is_same_v<Input, Schema>)
+			if constexpr (std::is_same_v<Input, Schema> || std::is_same_v<Input, ra::slice<Schema>>)
 			{
-				curr = r.begin();
-				begin = r.begin();
-				end = r.end();
+				curr_ = r.begin();
+				begin_ = r.begin();
+				end_ = r.end();
+				last_ = r.end();
+
+				if constexpr (std::is_same_v<Input, Schema>)
+				{
+					table_ = &r;
+				}
+				else
+				{
+					table_ = nullptr;
+				}
 			}
 			else
 			{
@@ -44,24 +199,80 @@ namespace ra
 			}
 		}
 
-		static inline void reset() noexcept
+		inline void reset() noexcept
 		{
-			curr = begin;
+			curr_ = begin_;
+			end_ = last_;
+		}
+
+		// number of rows the relation was seeded with, only slices of a sorted schema are counted by walking their rows
+		inline std::size_t size() const noexcept
+		{
+			if (table_ != nullptr)
+			{
+				return table_->size();
+			}
+
+			if constexpr (Schema::columnar || std::random_access_iterator<typename Schema::const_iterator>)
+			{
+				return last_ - begin_;
+			}
+			else
+			{
+				return std::distance(begin_, last_);
+			}
+		}
+
+		// generation of the seeded schema, zero for slices whose rows are not tracked
+		inline std::size_t generation() const noexcept
+		{
+			return table_ != nullptr ? table_->generation() : 0;
+		}
+
+		// narrows the stream to the rows whose Column equals key, the schema must be indexed on Column
+		template <cexpr::string Column, typename Key>
+		inline void seek(Key const& key)
+		{
+			static_assert(Schema::template ordered<Column>(), "Relation seek requires a schema indexed on the column.");
+
+			auto const [first, last]{ table_->equal_range(key) };
+			curr_ = first;
+			end_ = last;
 		}
 
 	private:
-		static Schema::const_iterator curr;
-		static Schema::const_iterator begin;
-		static Schema::const_iterator end;
-	};
+		// columns of Row which Predicate reads when Read is true, or does not read otherwise
+		template <typename Predicate, bool Read, typename Row>
+		static constexpr auto split()
+		{
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return sql::void_row{};
+			}
+			else
+			{
+				using next = decltype(split<Predicate, Read, typename Row::next>());
 
-	template <typename Schema, std::size_t Id>
-	Schema::const_iterator relation<Schema, Id>::curr{};
+				if constexpr (Predicate::template reads<Row::column::name>() == Read)
+				{
+					return sql::row<typename Row::column, next>{};
+				}
+				else
+				{
+					return next{};
+				}
+			}
+		}
 
-	template <typename Schema, std::size_t Id>
-	Schema::const_iterator relation<Schema, Id>::begin{};
+		Schema::const_iterator curr_{};
+		Schema::const_iterator begin_{};
+		Schema::const_iterator end_{};
+		Schema::const_iterator last_{};
+		Schema const* table_{};
 
-	template <typename Schema, std::size_t Id>
-	Schema::const_iterator relation<Schema, Id>::end{};
+		// column wise schemas are read into these rows, other schemas are pointed into directly
+		std::conditional_t<Schema::columnar, output_type, sql::void_row> output_row_{};
+		std::conditional_t<Schema::columnar, std::vector<output_type>, sql::void_row> buffer_{};
+	};
 
 } // namespace ra
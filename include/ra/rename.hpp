@@ -1,5 +1,8 @@
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include "ra/operation.hpp"
 
 #include "sql/row.hpp"
@@ -14,11 +17,46 @@ namespace ra
 	public:
 		using output_type = Output;
 
-		static auto&& next()
+		output_type const* next()
 		{
-			fold<output_type, input_type>(output_row, Input::next());
-			
-			return std::move(output_row);
+			auto const* row{ this->input_.next() };
+
+			if (row != nullptr)
+			{
+				fold<output_type, input_type>(output_row_, *row);
+
+				return &output_row_;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+				inputs_.resize(rows.size());
+			}
+
+			auto const size{ this->input_.next_batch(std::span{ inputs_.data(), rows.size() }) };
+
+			for (std::size_t i{}; i < size; ++i)
+			{
+				fold<output_type, input_type>(buffer_[i], *inputs_[i]);
+				rows[i] = &buffer_[i];
+			}
+
+			return size;
+		}
+
+		// each input row is one output row, so skipping rows skips as many input rows
+		inline std::size_t skip(std::size_t count)
+		{
+			return this->input_.skip(count);
 		}
 
 	private:
@@ -36,10 +74,9 @@ namespace ra
 			}
 		}
 
-		static output_type output_row;
+		output_type output_row_{};
+		std::vector<output_type> buffer_{};
+		std::vector<input_type const*> inputs_{};
 	};
-
-	template <typename Output, typename Input>
-	typename rename<Output, Input>::output_type rename<Output, Input>::output_row{};
 	
 } // namespace ra
@@ -1,10 +1,31 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "cexpr/string.hpp"
+
 #include "ra/operation.hpp"
+#include "ra/relation.hpp"
 
 namespace ra
 {
 
+	namespace
+	{
+
+		// column wise relations filter rows themselves so unread columns are never loaded
+		template <typename Input>
+		struct late : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct late<ra::relation<Schema, Id, Columns>> : std::bool_constant<Schema::columnar>
+		{};
+
+	} // namespace
+
 	template <typename Predicate, typename Input>
 	class selection : public ra::unary<Input>
 	{
@@ -12,23 +33,65 @@ namespace ra
 	public:
 		using output_type = input_type;		
 
-		static auto&& next()
+		output_type const* next()
 		{
-			output_row = Input::next();
+			if constexpr (late<Input>::value)
+			{
+				return this->input_.template next_where<Predicate>();
+			}
+			else
+			{
+				for (auto const* row{ this->input_.next() }; row != nullptr; row = this->input_.next())
+				{
+					if (Predicate::eval(*row))
+					{
+						return row;
+					}
+				}
+
+				return nullptr;
+			}
+		}
 
-			while(!Predicate::eval(output_row))
+		// filters an input batch in place, a batch is only refilled once none of its rows qualified
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if constexpr (late<Input>::value)
 			{
-				output_row = Input::next();
+				return this->input_.template next_batch_where<Predicate>(rows);
 			}
+			else
+			{
+				std::size_t size{};
+
+				while (size == 0)
+				{
+					auto const count{ this->input_.next_batch(rows) };
+
+					if (count == 0)
+					{
+						break;
+					}
 
-			return std::move(output_row);
+					for (std::size_t i{}; i < count; ++i)
+					{
+						if (Predicate::eval(*rows[i]))
+						{
+							rows[size++] = rows[i];
+						}
+					}
+				}
+
+				return size;
+			}
 		}
 
-	private:
-		static output_type output_row;
+		// narrows the input to the rows whose Column equals key
+		template <cexpr::string Column, typename Key>
+		inline void seek(Key const& key)
+		{
+			this->input_.template seek<Column>(key);
+		}
 	};
 
-	template <typename Output, typename Input>
-	typename selection<Output, Input>::output_type selection<Output, Input>::output_row{};
-
 } // namespace ra
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "cexpr/string.hpp"
+
+#include "ra/join.hpp"
+#include "ra/relation.hpp"
+
+#include "sql/row.hpp"
+
+namespace ra
+{
+
+	// merge join of inputs which arrive sorted ascending on their join keys, only the right rows
+	//	sharing the key of the current left row are buffered
+	template <typename LeftInput, typename RightInput, cexpr::string LeftKey, cexpr::string RightKey,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>>
+	class sorted : public ra::join<LeftInput, RightInput, Left, Right>
+	{
+		using join_type = ra::join<LeftInput, RightInput, Left, Right>;
+		using left_type = typename join_type::left_type;
+		using right_type = typename join_type::right_type;
+		using key_type = std::remove_cvref_t<decltype(sql::get<LeftKey>(typename join_type::left_input_type{}))>;
+		using value_type = decltype(remainder<left_type, right_type>());
+
+		static_assert(sql::exists<LeftKey, left_type>(), "Left join key must be carried into the output row.");
+	public:
+		using output_type = join_type::output_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+			restart();
+		}
+
+		void reset()
+		{
+			join_type::reset();
+			restart();
+		}
+
+		output_type const* next()
+		{
+			while (curr_ == end_)
+			{
+				if (!this->advance())
+				{
+					return nullptr;
+				}
+
+				match();
+			}
+
+			copy_after<left_type>(this->output_row_, *curr_++);
+
+			return &this->output_row_;
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			while (size < rows.size())
+			{
+				if (curr_ == end_)
+				{
+					if (!this->advance())
+					{
+						break;
+					}
+
+					match();
+				}
+				else
+				{
+					buffer_[size] = this->output_row_;
+					copy_after<left_type>(buffer_[size], *curr_++);
+					rows[size] = &buffer_[size];
+					++size;
+				}
+			}
+
+			return size;
+		}
+
+	private:
+		// rewinds the right stream after its input was seeded or reset
+		inline void restart()
+		{
+			row_ = this->right_.next();
+			group_.clear();
+			match();
+		}
+
+		// points the cursor at the right rows with the key of the current left row, left rows sharing
+		//	a key reuse the group and right rows with smaller keys are skipped
+		void match()
+		{
+			if (!this->active_)
+			{
+				curr_ = end_;
+
+				return;
+			}
+
+			auto const& key{ sql::get<LeftKey>(this->output_row_) };
+
+			if (group_.empty() || key_ != key)
+			{
+				group_.clear();
+
+				while (row_ != nullptr && sql::get<RightKey>(*row_) < key)
+				{
+					row_ = this->right_.next();
+				}
+
+				while (row_ != nullptr && sql::get<RightKey>(*row_) == key)
+				{
+					fold<sql::void_row, value_type>(group_.emplace_back(), *row_);
+					row_ = this->right_.next();
+				}
+
+				key_ = key;
+			}
+
+			curr_ = group_.data();
+			end_ = group_.data() + group_.size();
+		}
+
+		typename join_type::right_input_type const* row_{};
+		std::vector<value_type> group_{};
+		key_type key_{};
+		std::vector<output_type> buffer_{};
+		value_type const* curr_{};
+		value_type const* end_{};
+	};
+
+} // namespace ra
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "ra/aggregation.hpp"
+
+namespace ra
+{
+
+	// sort based aggregation of an input which arrives ordered on its one Keys column, the rows of a group
+	//	are adjacent so each group is output as soon as a row of the next key is read, and only the state
+	//	of the current group is kept
+	template <typename Output, typename Keys, typename Aggregates, typename Input>
+	class streamed : public ra::aggregation<Output, Keys, Aggregates, Input>
+	{
+		using base_type = ra::aggregation<Output, Keys, Aggregates, Input>;
+		using input_type = typename base_type::input_type;
+		using key_type = typename base_type::key_type;
+		using state_type = typename base_type::state_type;
+
+		static_assert(Keys::depth == 1, "Streamed aggregation groups on a single ordered column.");
+
+		static constexpr std::size_t batch_size{ 1024 };
+	public:
+		using output_type = Output;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			this->input_.seed(rs...);
+			restart();
+		}
+
+		void reset()
+		{
+			this->input_.reset();
+			restart();
+		}
+
+		// groups are output in ascending order of their keys
+		output_type const* next()
+		{
+			return advance(output_row_) ? &output_row_ : nullptr;
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			std::size_t size{};
+
+			for (; size < rows.size() && advance(buffer_[size]); ++size)
+			{
+				rows[size] = &buffer_[size];
+			}
+
+			return size;
+		}
+
+	private:
+		inline void restart()
+		{
+			rows_.resize(batch_size);
+			curr_ = 0;
+			count_ = 0;
+			open_ = false;
+			done_ = false;
+		}
+
+		// next input row, read from the input a batch at a time
+		inline input_type const* pull()
+		{
+			if (curr_ == count_)
+			{
+				count_ = done_ ? 0 : this->input_.next_batch(std::span{ rows_ });
+				curr_ = 0;
+				done_ = count_ == 0;
+
+				if (done_)
+				{
+					return nullptr;
+				}
+			}
+
+			return rows_[curr_++];
+		}
+
+		// folds input rows into the current group until a row of another key closes it, the closed group is output to dest
+		bool advance(output_type& dest)
+		{
+			for (auto row{ pull() }; row != nullptr; row = pull())
+			{
+				if (!open_)
+				{
+					key_ = base_type::key(*row);
+					base_type::init(state_, *row);
+					open_ = true;
+				}
+				else if (base_type::key(*row) == key_)
+				{
+					base_type::update(state_, *row);
+				}
+				else
+				{
+					base_type::emit(dest, state_);
+					key_ = base_type::key(*row);
+					base_type::init(state_, *row);
+
+					return true;
+				}
+			}
+
+			if (open_)
+			{
+				base_type::emit(dest, state_);
+				open_ = false;
+
+				return true;
+			}
+
+			return false;
+		}
+
+		std::vector<input_type const*> rows_{};
+		std::size_t curr_{};
+		std::size_t count_{};
+		bool open_{};
+		bool done_{};
+		key_type key_{};
+		state_type state_{};
+		output_type output_row_{};
+		std::vector<output_type> buffer_{};
+	};
+
+} // namespace ra
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "ra/operation.hpp"
+
+namespace ra
+{
+
+	// row count of a query without a LIMIT clause
+	inline constexpr std::size_t unlimited{ std::numeric_limits<std::size_t>::max() };
+
+	// first Limit input rows in the order of the sql::order Order, the input is drained in one pass when the
+	//	node is seeded into a heap holding at most Limit rows, whose root is the last row kept so far and is
+	//	replaced by every row which sorts before it, without a Limit every row is kept and sorted
+	template <typename Order, std::size_t Limit, typename Input>
+	class top : public ra::unary<Input>
+	{
+		using input_type = typename ra::unary<Input>::input_type;
+		using comparator = typename Order::template comparator<input_type>;
+
+		static constexpr std::size_t batch_size{ 1024 };
+	public:
+		using output_type = input_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			this->input_.seed(rs...);
+			rows_.clear();
+			curr_ = 0;
+
+			if constexpr (Limit != 0)
+			{
+				std::vector<input_type const*> rows(batch_size);
+
+				for (auto count{ this->input_.next_batch(std::span{ rows }) }; count != 0; count = this->input_.next_batch(std::span{ rows }))
+				{
+					for (std::size_t i{}; i < count; ++i)
+					{
+						keep(*rows[i]);
+					}
+				}
+
+				if constexpr (Limit == ra::unlimited)
+				{
+					std::sort(rows_.begin(), rows_.end(), comparator{});
+				}
+				else
+				{
+					std::sort_heap(rows_.begin(), rows_.end(), comparator{});
+				}
+			}
+		}
+
+		// replays the sorted rows, the input is only drained again when the node is seeded
+		inline void reset() noexcept
+		{
+			curr_ = 0;
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return rows_.size();
+		}
+
+		output_type const* next() noexcept
+		{
+			return curr_ < rows_.size() ? &rows_[curr_++] : nullptr;
+		}
+
+		// output rows are held by the node and stay valid until it is seeded again
+		std::size_t next_batch(std::span<output_type const*> rows) noexcept
+		{
+			std::size_t size{};
+
+			for (; size < rows.size() && curr_ < rows_.size(); ++size, ++curr_)
+			{
+				rows[size] = &rows_[curr_];
+			}
+
+			return size;
+		}
+
+		// advances past up to count sorted rows, returns the number of rows skipped
+		inline std::size_t skip(std::size_t count) noexcept
+		{
+			auto const size{ std::min(count, rows_.size() - curr_) };
+			curr_ += size;
+
+			return size;
+		}
+
+	private:
+		inline void keep(input_type const& row)
+		{
+			if constexpr (Limit == ra::unlimited)
+			{
+				rows_.push_back(row);
+			}
+			else if (rows_.size() < Limit)
+			{
+				rows_.push_back(row);
+				std::push_heap(rows_.begin(), rows_.end(), comparator{});
+			}
+			else if (comparator{}(row, rows_.front()))
+			{
+				std::pop_heap(rows_.begin(), rows_.end(), comparator{});
+				rows_.back() = row;
+				std::push_heap(rows_.begin(), rows_.end(), comparator{});
+			}
+		}
+
+		std::vector<input_type> rows_{};
+		std::size_t curr_{};
+	};
+
+} // namespace ra
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+#include "cexpr/string.hpp"
+
+#include "sql/column.hpp"
+#include "sql/predicate.hpp"
+#include "sql/row.hpp"
+
+namespace sql
+{
+
+	namespace
+	{
+
+		// value held by a column of type Type, the type inside std::optional for nullable columns
+		template <typename Type>
+		using held = typename nullable_type<Type>::type::value_type;
+
+		// type sums of Type accumulate in, integers widen to 64 bits and floating point types to double
+		template <typename Type>
+		using accumulator = std::conditional_t<std::is_floating_point_v<Type>, double,
+			std::conditional_t<std::is_signed_v<Type>, std::int64_t, std::uint64_t>>;
+
+		// aggregates whose groups may hold no value output std::optional columns which are null for them
+		template <typename Type, bool Nullable>
+		constexpr auto finish(std::optional<Type> const& acc)
+		{
+			if constexpr (Nullable)
+			{
+				return acc;
+			}
+			else
+			{
+				return *acc;
+			}
+		}
+
+	} // namespace
+
+	// aggregate nodes compute one output column of a query with GROUP BY or aggregates, init starts the state of a group
+	//	from its first row, update folds every later row of the group into it, and result reads the column,
+	//	a default constructed state is the state of a group without rows
+
+	// GROUP BY column, every row of a group holds the same value
+	template <cexpr::string Column, typename Type>
+	struct grouped
+	{
+		using state = Type;
+		using type = Type;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row)
+		{
+			acc = sql::get<Column>(row);
+		}
+
+		template <typename Row>
+		static inline void update([[maybe_unused]] state& acc, [[maybe_unused]] Row const& row) noexcept
+		{}
+
+		static inline type const& result(state const& acc) noexcept
+		{
+			return acc;
+		}
+	};
+
+	// COUNT(*) counts the rows of a group, COUNT(Column) the rows whose Column is not null
+	template <cexpr::string Column>
+	struct count
+	{
+		using state = std::size_t;
+		using type = std::size_t;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row) noexcept
+		{
+			acc = counted(row) ? 1 : 0;
+		}
+
+		template <typename Row>
+		static inline void update(state& acc, Row const& row) noexcept
+		{
+			acc += counted(row) ? 1 : 0;
+		}
+
+		static inline type result(state const& acc) noexcept
+		{
+			return acc;
+		}
+
+	private:
+		template <typename Row>
+		static inline bool counted([[maybe_unused]] Row const& row) noexcept
+		{
+			if constexpr (Column == "*")
+			{
+				return true;
+			}
+			else
+			{
+				return known(sql::get<Column>(row));
+			}
+		}
+	};
+
+	// SUM(Column) of the non null values of the Type column, Nullable when a group may hold none of them
+	template <cexpr::string Column, typename Type, bool Nullable>
+	struct sum
+	{
+		static_assert(std::is_arithmetic_v<held<Type>>, "SUM requires a numeric column.");
+
+		using state = std::optional<accumulator<held<Type>>>;
+		using type = std::conditional_t<Nullable, state, typename state::value_type>;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row) noexcept
+		{
+			acc.reset();
+			update(acc, row);
+		}
+
+		template <typename Row>
+		static inline void update(state& acc, Row const& row) noexcept
+		{
+			auto const& val{ sql::get<Column>(row) };
+
+			if (known(val))
+			{
+				acc = acc.value_or(0) + unwrap(val);
+			}
+		}
+
+		static inline type result(state const& acc) noexcept
+		{
+			return finish<typename state::value_type, Nullable>(acc);
+		}
+	};
+
+	// AVG(Column), the mean of the non null values of the Type column as a double
+	template <cexpr::string Column, typename Type, bool Nullable>
+	struct avg
+	{
+		static_assert(std::is_arithmetic_v<held<Type>>, "AVG requires a numeric column.");
+
+		struct state
+		{
+			double sum;
+			std::size_t count;
+		};
+
+		using type = std::conditional_t<Nullable, std::optional<double>, double>;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row) noexcept
+		{
+			acc = state{};
+			update(acc, row);
+		}
+
+		template <typename Row>
+		static inline void update(state& acc, Row const& row) noexcept
+		{
+			auto const& val{ sql::get<Column>(row) };
+
+			if (known(val))
+			{
+				acc.sum += unwrap(val);
+				++acc.count;
+			}
+		}
+
+		static inline type result(state const& acc) noexcept
+		{
+			return finish<double, Nullable>(acc.count == 0 ? std::optional<double>{} : acc.sum / acc.count);
+		}
+	};
+
+	// MIN(Column) when Less is true, otherwise MAX(Column), of the non null values of the Type column
+	template <cexpr::string Column, typename Type, bool Nullable, bool Less>
+	struct extreme
+	{
+		using state = std::optional<held<Type>>;
+		using type = std::conditional_t<Nullable, state, typename state::value_type>;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row)
+		{
+			acc.reset();
+			update(acc, row);
+		}
+
+		template <typename Row>
+		static inline void update(state& acc, Row const& row)
+		{
+			auto const& val{ sql::get<Column>(row) };
+
+			if (known(val) && (!acc || (Less ? unwrap(val) < *acc : *acc < unwrap(val))))
+			{
+				acc = unwrap(val);
+			}
+		}
+
+		static inline type result(state const& acc)
+		{
+			return finish<typename state::value_type, Nullable>(acc);
+		}
+	};
+
+	template <cexpr::string Column, typename Type, bool Nullable>
+	using min = extreme<Column, Type, Nullable, true>;
+
+	template <cexpr::string Column, typename Type, bool Nullable>
+	using max = extreme<Column, Type, Nullable, false>;
+
+} // namespace sql
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <optional>
+#include <type_traits>
+
 #include "cexpr/string.hpp"
 
 namespace sql
@@ -13,4 +16,26 @@ namespace sql
 		using type = Type;
 	};
 
+	namespace
+	{
+
+		// true for the types of nullable columns, type is the optional Type nullable columns hold
+		template <typename Type>
+		struct nullable_type : std::false_type
+		{
+			using type = std::optional<Type>;
+		};
+
+		template <typename Type>
+		struct nullable_type<std::optional<Type>> : std::true_type
+		{
+			using type = std::optional<Type>;
+		};
+
+	} // namespace
+
+	// column of the same name whose values may be null, used for the padded inputs of outer joins
+	template <typename Col>
+	using nullable = column<Col::name, typename nullable_type<typename Col::type>::type>;
+
 } // namespace sql
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sql/row.hpp"
+
+namespace sql
+{
+
+	// sql::schema index argument which stores the data column wise (unsorted)
+	struct columnar
+	{};
+
+	// template recursive list of contiguous arrays, one per column of Row
+	template <typename Row>
+	class column_store
+	{
+	public:
+		using column = Row::column;
+		using next = column_store<typename Row::next>;
+
+		class const_iterator
+		{
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = Row;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = Row;
+
+			const_iterator() = default;
+
+			const_iterator(column_store const* store, std::size_t index) : store_{ store }, index_{ index }
+			{}
+
+			inline bool operator==(const_iterator const& it) const noexcept
+			{
+				return index_ == it.index_;
+			}
+
+			inline bool operator!=(const_iterator const& it) const noexcept
+			{
+				return !(*this == it);
+			}
+
+			// rows are materialized from the columns on dereference
+			inline Row operator*() const
+			{
+				Row row{};
+				load<Row>(row);
+
+				return row;
+			}
+
+			inline const_iterator& operator++() noexcept
+			{
+				++index_;
+
+				return *this;
+			}
+
+			inline const_iterator operator++(int) noexcept
+			{
+				return const_iterator{ store_, index_++ };
+			}
+
+			inline const_iterator& operator+=(std::size_t n) noexcept
+			{
+				index_ += n;
+
+				return *this;
+			}
+
+			inline difference_type operator-(const_iterator const& it) const noexcept
+			{
+				return index_ - it.index_;
+			}
+
+			// copies only the columns named in Cols into the row
+			template <typename Cols, typename Dest>
+			inline void load(Dest& row) const
+			{
+				store_->template load<Cols>(index_, row);
+			}
+
+			// copies only the columns named in Cols into consecutive rows, one column at a time
+			template <typename Cols, typename Dest>
+			inline void load(std::span<Dest> rows) const
+			{
+				store_->template load<Cols>(index_, rows);
+			}
+
+		private:
+			column_store const* store_{};
+			std::size_t index_{};
+		};
+
+		template <typename Type, typename... Types>
+		inline void emplace_back(Type&& val, Types&&... vals)
+		{
+			data_.emplace_back(std::forward<Type>(val));
+			next_.emplace_back(std::forward<Types>(vals)...);
+		}
+
+		inline void push_back(Row const& row)
+		{
+			data_.push_back(row.head());
+			next_.push_back(row.tail());
+		}
+
+		inline void push_back(Row&& row)
+		{
+			data_.push_back(std::move(row.head()));
+			next_.push_back(std::move(row.tail()));
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return data_.size();
+		}
+
+		inline const_iterator begin() const noexcept
+		{
+			return const_iterator{ this, 0 };
+		}
+
+		inline const_iterator end() const noexcept
+		{
+			return const_iterator{ this, data_.size() };
+		}
+
+		template <typename Cols, typename Dest>
+		void load(std::size_t index, Dest& row) const
+		{
+			if constexpr (sql::exists<column::name, Cols>())
+			{
+				sql::set<column::name>(row, data_[index]);
+			}
+
+			next_.template load<Cols>(index, row);
+		}
+
+		template <typename Cols, typename Dest>
+		void load(std::size_t first, std::span<Dest> rows) const
+		{
+			if constexpr (sql::exists<column::name, Cols>())
+			{
+				for (std::size_t i{}; i < rows.size(); ++i)
+				{
+					sql::set<column::name>(rows[i], data_[first + i]);
+				}
+			}
+
+			next_.template load<Cols>(first, rows);
+		}
+
+	private:
+		std::vector<typename column::type> data_;
+		next next_;
+	};
+
+	template <>
+	class column_store<sql::void_row>
+	{
+	public:
+		inline void emplace_back() noexcept
+		{}
+
+		inline void push_back([[maybe_unused]] sql::void_row const& row) noexcept
+		{}
+
+		template <typename Cols, typename Dest>
+		inline void load([[maybe_unused]] std::size_t index, [[maybe_unused]] Dest& row) const noexcept
+		{}
+	};
+
+} // namespace sql
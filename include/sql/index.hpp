@@ -12,15 +12,51 @@ namespace sql
 	template <cexpr::string... Columns>
 	struct index
 	{
+		// true when rows are sorted on the Name column before any other
+		template <cexpr::string Name>
+		static constexpr bool leads() noexcept
+		{
+			if constexpr (sizeof...(Columns) == 0)
+			{
+				return false;
+			}
+			else
+			{
+				return first<Name, Columns...>();
+			}
+		}
+
 		template <typename Row>
 		struct comparator
 		{
+			// allows multiset lookups by a value of the leading column
+			using is_transparent = void;
+
 			bool operator()(Row const& left, Row const& right) const noexcept
 			{
 				return compare<Columns...>(left, right);
 			}
+
+			template <typename Key>
+			bool operator()(Row const& left, Key const& right) const noexcept
+			{
+				return leading<Columns...>(left) < right;
+			}
+
+			template <typename Key>
+			bool operator()(Key const& left, Row const& right) const noexcept
+			{
+				return left < leading<Columns...>(right);
+			}
 		
 		private:
+			template <cexpr::string Col, cexpr::string... Cols>
+			static inline auto const& leading(Row const& row) noexcept
+			{
+				return sql::get<Col>(row);
+			}
+
+
 			template <cexpr::string Col, cexpr::string... Cols>
 			bool compare(Row const& left, Row const& right) const noexcept
 			{
@@ -38,6 +74,13 @@ namespace sql
 				return l < r;
 			}
 		};
+
+	private:
+		template <cexpr::string Name, cexpr::string Col, cexpr::string... Cols>
+		static constexpr bool first() noexcept
+		{
+			return Col == Name;
+		}
 	};
 
 } // namespace sql
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "cexpr/string.hpp"
+
+#include "sql/row.hpp"
+
+namespace sql
+{
+
+	// column of an ORDER BY clause, descending columns order their largest values first
+	template <cexpr::string Name, bool Descending>
+	struct direction
+	{
+		static constexpr auto name{ Name };
+		static constexpr bool descending{ Descending };
+	};
+
+	// ORDER BY clause over the sql::direction Columns, earlier columns take precedence
+	template <typename... Columns>
+	struct order
+	{
+		template <typename Row>
+		struct comparator
+		{
+			bool operator()(Row const& left, Row const& right) const noexcept
+			{
+				return compare<Columns...>(left, right);
+			}
+
+		private:
+			template <typename Col, typename... Cols>
+			bool compare(Row const& left, Row const& right) const noexcept
+			{
+				auto const& l{ sql::get<Col::name>(left) };
+				auto const& r{ sql::get<Col::name>(right) };
+
+				if constexpr (sizeof...(Cols) != 0)
+				{
+					if (l == r)
+					{
+						return compare<Cols...>(left, right);
+					}
+				}
+
+				if constexpr (Col::descending)
+				{
+					return r < l;
+				}
+				else
+				{
+					return l < r;
+				}
+			}
+		};
+	};
+
+} // namespace sql
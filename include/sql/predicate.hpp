@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cstddef>
+#include <type_traits>
 
 #include "cexpr/string.hpp"
 
+#include "sql/column.hpp"
+
 namespace sql
 {
 
@@ -20,48 +23,144 @@ namespace sql
 			Type val;
 		};
 
-	} // namespace
+		// rebinds a predicate node to evaluate over another row type, void stays void
+		template <typename Node, typename Row>
+		struct rebound
+		{
+			using type = typename Node::template rebind<Row>;
+		};
 
-	template <cexpr::string Op, typename Row, typename Left, typename Right=void>
-	struct operation
-	{
-		static constexpr bool eval(Row const& row) noexcept
+		template <typename Row>
+		struct rebound<void, Row>
+		{
+			using type = void;
+		};
+
+		// false for null values of nullable columns
+		template <typename Type>
+		constexpr bool known([[maybe_unused]] Type const& val) noexcept
+		{
+			if constexpr (nullable_type<Type>::value)
+			{
+				return val.has_value();
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		// value held by a nullable column, other values are returned as is
+		template <typename Type>
+		constexpr auto const& unwrap(Type const& val) noexcept
+		{
+			if constexpr (nullable_type<Type>::value)
+			{
+				return *val;
+			}
+			else
+			{
+				return val;
+			}
+		}
+
+		template <cexpr::string Op, typename Left, typename Right>
+		constexpr bool compare(Left const& left, Right const& right) noexcept
 		{
 			if constexpr (Op == "=")
 			{
-				return Left::eval(row) == Right::eval(row);
+				return left == right;
 			}
 			else if constexpr (Op == ">")
 			{
-				return Left::eval(row) > Right::eval(row);
+				return left > right;
 			}
 			else if constexpr(Op == "<")
 			{
-				return Left::eval(row) < Right::eval(row);
+				return left < right;
 			}
 			else if constexpr(Op == ">=")
 			{
-				return Left::eval(row) >= Right::eval(row);
+				return left >= right;
 			}
 			else if constexpr(Op == "<=")
 			{
-				return Left::eval(row) <= Right::eval(row);
+				return left <= right;
 			}
-			else if constexpr(Op == "!=" || Op == "<>")
+			else
 			{
-				return Left::eval(row) != Right::eval(row);
+				return left != right;
 			}
-			else if constexpr(Op == "AND")
+		}
+
+	} // namespace
+
+	template <cexpr::string Op, typename Row, typename Left, typename Right=void>
+	struct operation
+	{
+		// the same predicate evaluated over rows of type Other
+		template <typename Other>
+		using rebind = operation<Op, Other, typename rebound<Left, Other>::type, typename rebound<Right, Other>::type>;
+
+		// true when the predicate holds, comparisons with a null column are neither true nor false
+		static constexpr bool eval(Row const& row) noexcept
+		{
+			if constexpr (Op == "AND")
 			{
 				return Left::eval(row) && Right::eval(row);
 			}
-			else if constexpr(Op == "OR")
+			else if constexpr (Op == "OR")
 			{
 				return Left::eval(row) || Right::eval(row);
 			}
-			else if constexpr(Op == "NOT")
+			else if constexpr (Op == "NOT")
 			{
-				return !Left::eval(row);
+				return Left::refute(row);
+			}
+			else
+			{
+				auto const& left{ Left::eval(row) };
+				auto const& right{ Right::eval(row) };
+
+				return known(left) && known(right) && compare<Op>(unwrap(left), unwrap(right));
+			}
+		}
+
+		// true when the predicate is false, which only differs from !eval when a null column is compared
+		static constexpr bool refute(Row const& row) noexcept
+		{
+			if constexpr (Op == "AND")
+			{
+				return Left::refute(row) || Right::refute(row);
+			}
+			else if constexpr (Op == "OR")
+			{
+				return Left::refute(row) && Right::refute(row);
+			}
+			else if constexpr (Op == "NOT")
+			{
+				return Left::eval(row);
+			}
+			else
+			{
+				auto const& left{ Left::eval(row) };
+				auto const& right{ Right::eval(row) };
+
+				return known(left) && known(right) && !compare<Op>(unwrap(left), unwrap(right));
+			}
+		}
+
+		// true when evaluating the predicate reads the column Name
+		template <cexpr::string Name>
+		static constexpr bool reads() noexcept
+		{
+			if constexpr (std::is_void_v<Right>)
+			{
+				return Left::template reads<Name>();
+			}
+			else
+			{
+				return Left::template reads<Name>() || Right::template reads<Name>();
 			}
 		}
 	};
@@ -69,19 +168,48 @@ namespace sql
 	template <cexpr::string Column, typename Row>
 	struct variable
 	{
-		static constexpr auto eval(Row const& row) noexcept
+		template <typename Other>
+		using rebind = variable<Column, Other>;
+
+		// the column is read in place, so comparing a string column copies no string
+		static constexpr decltype(auto) eval(Row const& row) noexcept
 		{
 			return sql::get<Column>(row);
 		}
+
+		static constexpr bool refute(Row const& row) noexcept
+		{
+			return !eval(row);
+		}
+
+		template <cexpr::string Name>
+		static constexpr bool reads() noexcept
+		{
+			return Column == Name;
+		}
 	};
 
 	template <auto Const, typename Row>
 	struct constant
 	{
+		template <typename Other>
+		using rebind = constant<Const, Other>;
+
 		static constexpr auto eval([[maybe_unused]] Row const& row) noexcept
 		{
 			return Const.val;
 		}
+
+		static constexpr bool refute(Row const& row) noexcept
+		{
+			return !eval(row);
+		}
+
+		template <cexpr::string Name>
+		static constexpr bool reads() noexcept
+		{
+			return false;
+		}
 	};
 
 } // namespace sql
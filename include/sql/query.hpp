@@ -1,24 +1,42 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <iterator>
+#include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 #include "cexpr/string.hpp"
 
 #include "ra/cross.hpp"
+#include "ra/group.hpp"
+#include "ra/indexed.hpp"
+#include "ra/inner.hpp"
 #include "ra/join.hpp"
+#include "ra/limit.hpp"
 #include "ra/natural.hpp"
+#include "ra/outer.hpp"
 #include "ra/projection.hpp"
 #include "ra/relation.hpp"
 #include "ra/rename.hpp"
 #include "ra/selection.hpp"
+#include "ra/sorted.hpp"
+#include "ra/streamed.hpp"
+#include "ra/top.hpp"
 
+#include "sql/aggregate.hpp"
 #include "sql/column.hpp"
+#include "sql/order.hpp"
 #include "sql/tokens.hpp"
 #include "sql/predicate.hpp"
 #include "sql/row.hpp"
+#include "sql/schema.hpp"
 
 namespace sql
 {
@@ -42,23 +60,519 @@ namespace sql
 			static constexpr std::size_t next = Next;
 		};
 
+		// output row of the select list of a grouped query and the aggregates computing each of its columns
+		template <typename Output, typename Aggregates>
+		struct selects
+		{
+			using output = Output;
+			using aggregates = Aggregates;
+		};
+
+		// prepends the Col direction to an ORDER BY clause
+		template <typename Col, typename... Cols>
+		constexpr auto prepend(sql::order<Cols...>) noexcept
+		{
+			return sql::order<Col, Cols...>{};
+		}
+
+		// LIMIT clause ending before Pos, Count rows are output after skipping Offset rows
+		template <std::size_t Pos, std::size_t Count, std::size_t Offset>
+		struct bounds
+		{
+			static constexpr std::size_t pos{ Pos };
+			static constexpr std::size_t count{ Count };
+			static constexpr std::size_t offset{ Offset };
+		};
+
+		// expression trees which only scan, filter, and transform a single relation
+		template <typename Node>
+		struct scan : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct scan<ra::relation<Schema, Id, Columns>> : std::true_type
+		{
+			using schema = Schema;
+		};
+
+		template <typename Predicate, typename Input>
+		struct scan<ra::selection<Predicate, Input>> : scan<Input>
+		{};
+
+		template <typename Output, typename Input>
+		struct scan<ra::projection<Output, Input>> : scan<Input>
+		{};
+
+		template <typename Output, typename Input>
+		struct scan<ra::rename<Output, Input>> : scan<Input>
+		{};
+
+		// expression trees which can narrow their scan to the rows of one key through a schema index
+		template <typename Node>
+		struct seekable : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct seekable<ra::relation<Schema, Id, Columns>> : std::true_type
+		{};
+
+		template <typename Predicate, typename Input>
+		struct seekable<ra::selection<Predicate, Input>> : seekable<Input>
+		{};
+
+		// expression trees outputting one row per row of a scan or of sorted rows, which pass over rows without reading them
+		template <typename Node>
+		struct skippable : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct skippable<ra::relation<Schema, Id, Columns>> : std::true_type
+		{};
+
+		template <typename Output, typename Input>
+		struct skippable<ra::projection<Output, Input>> : skippable<Input>
+		{};
+
+		template <typename Output, typename Input>
+		struct skippable<ra::rename<Output, Input>> : skippable<Input>
+		{};
+
+		template <typename Order, std::size_t Limit, typename Input>
+		struct skippable<ra::top<Order, Limit, Input>> : std::true_type
+		{};
+
+		// true when the column of the renamed Output row named Name holds the Input column of the same name
+		template <cexpr::string Name, typename Output, typename Input>
+		constexpr bool unrenamed() noexcept
+		{
+			if constexpr (Output::depth == 0)
+			{
+				return false;
+			}
+			else if constexpr (Output::column::name == Name)
+			{
+				return Input::column::name == Name;
+			}
+			else
+			{
+				return unrenamed<Name, typename Output::next, typename Input::next>();
+			}
+		}
+
+		// expression trees streaming their rows in ascending order of the Name column, which is only carried
+		//	through a rename by a column keeping the name of the column it holds
+		template <typename Node, cexpr::string Name>
+		struct sorted_on : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns, cexpr::string Name>
+		struct sorted_on<ra::relation<Schema, Id, Columns>, Name> : std::bool_constant<Schema::template ordered<Name>()>
+		{};
+
+		template <typename Predicate, typename Input, cexpr::string Name>
+		struct sorted_on<ra::selection<Predicate, Input>, Name> : sorted_on<Input, Name>
+		{};
+
+		template <typename Output, typename Input, cexpr::string Name>
+		struct sorted_on<ra::projection<Output, Input>, Name> : sorted_on<Input, Name>
+		{};
+
+		template <typename Output, typename Input, cexpr::string Name>
+		struct sorted_on<ra::rename<Output, Input>, Name>
+			: std::bool_constant<unrenamed<Name, Output, std::remove_cvref_t<typename Input::output_type>>() && sorted_on<Input, Name>::value>
+		{};
+
+		// true when Node streams its rows in ascending order of the Name column
+		template <typename Node, cexpr::string Name>
+		constexpr bool ordered() noexcept
+		{
+			return sorted_on<Node, Name>::value;
+		}
+
+		// true when Node outputs the rows sharing a value of the one Keys column together
+		template <typename Node, typename Keys>
+		constexpr bool streamable() noexcept
+		{
+			if constexpr (Keys::depth == 1)
+			{
+				return ordered<Node, Keys::column::name>();
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		// Row less the column named Name
 		template <cexpr::string Name, typename Row>
-		constexpr bool exists() noexcept
+		constexpr auto without()
 		{
 			if constexpr (std::is_same_v<Row, sql::void_row>)
 			{
-				return false;
+				return sql::void_row{};
+			}
+			else if constexpr (Row::column::name == Name)
+			{
+				return typename Row::next{};
+			}
+			else
+			{
+				using next = decltype(without<Name, typename Row::next>());
+
+				return sql::row<typename Row::column, next>{};
+			}
+		}
+
+		// left columns which hide right columns of the same name, a key named alike on both sides holds equal values
+		template <typename LeftCols, cexpr::string LeftKey, cexpr::string RightKey>
+		constexpr auto hidden()
+		{
+			if constexpr (LeftKey == RightKey)
+			{
+				return without<LeftKey, LeftCols>();
 			}
 			else
 			{
-				if constexpr (Row::column::name == Name)
+				return LeftCols{};
+			}
+		}
+
+		// expected rows of a join chain relation, zero unless it scans a schema with a cardinality hint
+		template <typename Node>
+		constexpr std::size_t estimate() noexcept
+		{
+			if constexpr (scan<Node>::value)
+			{
+				return sql::cardinality<typename scan<Node>::schema>;
+			}
+			else
+			{
+				return 0;
+			}
+		}
+
+		// inner equi join nodes, the joins of a chain which may be reordered
+		template <typename Node>
+		struct equi : std::false_type
+		{};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols, ra::side Build>
+		struct equi<ra::inner<Left, Right, LeftKey, RightKey, LeftCols, RightCols, Build>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+
+			static constexpr auto left_key{ LeftKey };
+			static constexpr auto right_key{ RightKey };
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		struct equi<ra::sorted<Left, Right, LeftKey, RightKey, LeftCols, RightCols>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+
+			static constexpr auto left_key{ LeftKey };
+			static constexpr auto right_key{ RightKey };
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		struct equi<ra::indexed<Left, Right, LeftKey, RightKey, LeftCols, RightCols>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+
+			static constexpr auto left_key{ LeftKey };
+			static constexpr auto right_key{ RightKey };
+		};
+
+		// ON clause equating the LeftKey column of the relation at LeftId of a join chain with the RightKey column of the one at RightId
+		template <std::size_t LeftId, cexpr::string LeftKey, std::size_t RightId, cexpr::string RightKey>
+		struct link
+		{
+			static constexpr std::size_t left_id{ LeftId };
+			static constexpr auto left_key{ LeftKey };
+			static constexpr std::size_t right_id{ RightId };
+			static constexpr auto right_key{ RightKey };
+		};
+
+		// order a chain joins its relations in, and the link joining each relation to the ones before it
+		template <std::size_t Size>
+		struct plan
+		{
+			std::array<std::size_t, Size> ids{};
+			std::array<std::size_t, Size> links{};
+		};
+
+		// relations of a left deep chain of inner equi joins in written order, and the links between them
+		template <typename Relations, typename Links>
+		struct chain;
+
+		template <typename... Relations, typename... Links>
+		struct chain<std::tuple<Relations...>, std::tuple<Links...>>
+		{
+			using relations = std::tuple<Relations...>;
+			using links = std::tuple<Links...>;
+
+			template <std::size_t Id, cexpr::string Name>
+			using column_type = std::remove_cvref_t<decltype(sql::get<Name>(std::remove_cvref_t<typename std::tuple_element_t<Id, relations>::output_type>{}))>;
+
+			static constexpr std::size_t size{ sizeof...(Relations) };
+
+			// every relation scans a schema with a cardinality hint
+			static constexpr bool hinted{ ((estimate<Relations>() != 0) && ...) };
+
+			// links naming the same column on both sides, whose columns merge into one
+			static constexpr std::size_t equated{ ((Links::left_key == Links::right_key ? 1 : 0) + ... + 0) };
+
+			// columns merged by a link hold the same type
+			static constexpr bool typed{ ((Links::left_key != Links::right_key || std::is_same_v<column_type<Links::left_id, Links::left_key>, column_type<Links::right_id, Links::right_key>>) && ...) };
+
+			// starts from the smallest relation, then joins the smallest relation linked to the ones joined so far,
+			//	ties keep the written order
+			static constexpr plan<size> order() noexcept
+			{
+				std::array<std::size_t, size> const rows{ estimate<Relations>()... };
+				std::array<std::size_t, size - 1> const lefts{ Links::left_id... };
+				std::array<std::size_t, size - 1> const rights{ Links::right_id... };
+				std::array<bool, size> joined{};
+				plan<size> result{};
+
+				for (std::size_t step{}; step < size; ++step)
 				{
-					return true;
+					std::size_t best{ size };
+
+					for (std::size_t id{}; id < size; ++id)
+					{
+						if (joined[id] || (best != size && rows[best] <= rows[id]))
+						{
+							continue;
+						}
+
+						for (std::size_t l{}; l < size - 1 && best != id; ++l)
+						{
+							if (step == 0 || (lefts[l] == id && joined[rights[l]]) || (rights[l] == id && joined[lefts[l]]))
+							{
+								best = id;
+								result.links[step] = l;
+							}
+						}
+					}
+
+					result.ids[step] = best;
+					joined[best] = true;
 				}
-				else
+
+				return result;
+			}
+
+			// the planned order differs from the written one
+			static constexpr bool reordered() noexcept
+			{
+				auto const result{ order() };
+
+				for (std::size_t id{}; id < size; ++id)
 				{
-					return exists<Name, typename Row::next>();
+					if (result.ids[id] != id)
+					{
+						return true;
+					}
 				}
+
+				return false;
+			}
+		};
+
+		// position of the first relation of Relations whose rows carry the Name column, the one a join's merged row takes it from
+		template <cexpr::string Name, typename Relations, std::size_t Id = 0>
+		constexpr std::size_t owner() noexcept
+		{
+			static_assert(Id < std::tuple_size_v<Relations>, "Join key was not carried by any joined relation.");
+
+			if constexpr (sql::exists<Name, std::remove_cvref_t<typename std::tuple_element_t<Id, Relations>::output_type>>())
+			{
+				return Id;
+			}
+			else
+			{
+				return owner<Name, Relations, Id + 1>();
+			}
+		}
+
+		// Tuple with Type appended
+		template <typename Tuple, typename Type>
+		struct append;
+
+		template <typename... Types, typename Type>
+		struct append<std::tuple<Types...>, Type>
+		{
+			using type = std::tuple<Types..., Type>;
+		};
+
+		// chain of the inner equi joins along the left edge of Node, other nodes are a chain of one relation
+		template <typename Node>
+		constexpr auto flatten()
+		{
+			if constexpr (equi<Node>::value)
+			{
+				using join = equi<Node>;
+				using prefix = decltype(flatten<typename join::left>());
+				using relations = typename prefix::relations;
+				using next = link<owner<join::left_key, relations>(), join::left_key, std::tuple_size_v<relations>, join::right_key>;
+
+				return chain<typename append<relations, typename join::right>::type, typename append<typename prefix::links, next>::type>{};
+			}
+			else
+			{
+				return chain<std::tuple<Node>, std::tuple<>>{};
+			}
+		}
+
+		// exposes the operands of AND predicate nodes
+		template <typename Node>
+		struct conjunction : std::false_type
+		{};
+
+		template <typename Row, typename Left, typename Right>
+		struct conjunction<sql::operation<"AND", Row, Left, Right>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+		};
+
+		// exposes the columns of predicate nodes comparing two columns for equality
+		template <typename Node>
+		struct equality : std::false_type
+		{};
+
+		template <typename Row, cexpr::string LeftColumn, cexpr::string RightColumn>
+		struct equality<sql::operation<"=", Row, sql::variable<LeftColumn, Row>, sql::variable<RightColumn, Row>>> : std::true_type
+		{
+			static constexpr auto left{ LeftColumn };
+			static constexpr auto right{ RightColumn };
+		};
+
+		// equality conjunct Conjunct oriented so LeftKey is a column of the left input and RightKey one of the right input
+		template <cexpr::string LeftKey, cexpr::string RightKey, typename Conjunct>
+		struct keyed
+		{
+			static constexpr auto left_key{ LeftKey };
+			static constexpr auto right_key{ RightKey };
+
+			using conjunct = Conjunct;
+		};
+
+		// cross join nodes, which an equality of a column of each input turns into an equi join
+		template <typename Node>
+		struct product : std::false_type
+		{};
+
+		template <typename Left, typename Right, typename LeftCols, typename RightCols, std::size_t Block>
+		struct product<ra::cross<Left, Right, LeftCols, RightCols, Block>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using left_columns = LeftCols;
+			using right_columns = RightCols;
+		};
+
+		// exposes the inputs of join nodes, shadow holds the left columns which hide right columns of the same name
+		template <typename Node>
+		struct join_inputs : std::false_type
+		{};
+
+		template <typename Left, typename Right, typename LeftCols, typename RightCols, ra::side Build>
+		struct join_inputs<ra::natural<Left, Right, LeftCols, RightCols, Build>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = typename LeftCols::next;
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::natural<NewLeft, NewRight, LeftCols, RightCols, Build>;
+		};
+
+		template <typename Left, typename Right, typename LeftCols, typename RightCols, std::size_t Block>
+		struct join_inputs<ra::cross<Left, Right, LeftCols, RightCols, Block>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = LeftCols;
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::cross<NewLeft, NewRight, LeftCols, RightCols, Block>;
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols, ra::side Build>
+		struct join_inputs<ra::inner<Left, Right, LeftKey, RightKey, LeftCols, RightCols, Build>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = decltype(hidden<LeftCols, LeftKey, RightKey>());
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::inner<NewLeft, NewRight, LeftKey, RightKey, LeftCols, RightCols, Build>;
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols, ra::keep Keep>
+		struct join_inputs<ra::outer<Left, Right, LeftKey, RightKey, LeftCols, RightCols, Keep>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = LeftCols;
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::outer<NewLeft, NewRight, LeftKey, RightKey, LeftCols, RightCols, Keep>;
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		struct join_inputs<ra::indexed<Left, Right, LeftKey, RightKey, LeftCols, RightCols>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = decltype(hidden<LeftCols, LeftKey, RightKey>());
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::indexed<NewLeft, NewRight, LeftKey, RightKey, LeftCols, RightCols>;
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		struct join_inputs<ra::sorted<Left, Right, LeftKey, RightKey, LeftCols, RightCols>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = decltype(hidden<LeftCols, LeftKey, RightKey>());
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::sorted<NewLeft, NewRight, LeftKey, RightKey, LeftCols, RightCols>;
+		};
+
+		// inputs of join nodes padded with nulls, filtering them before the join would pad the rows it removes
+		template <typename Node>
+		struct padding
+		{
+			static constexpr bool left{ false };
+			static constexpr bool right{ false };
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols, ra::keep Keep>
+		struct padding<ra::outer<Left, Right, LeftKey, RightKey, LeftCols, RightCols, Keep>>
+		{
+			static constexpr bool left{ Keep != ra::keep::left };
+			static constexpr bool right{ Keep != ra::keep::right };
+		};
+
+		// column type held by view rows, strings refer into the schema storage and other types are copied
+		template <typename Type>
+		constexpr auto view_type()
+		{
+			if constexpr (std::is_same_v<Type, std::string>)
+			{
+				return std::string_view{};
+			}
+			else
+			{
+				return Type{};
 			}
 		}
 
@@ -126,6 +640,42 @@ namespace sql
 			return tv == "JOIN" || tv == "join";
 		}
 
+		inline constexpr bool isinner(std::string_view const& tv) noexcept
+		{
+			return tv == "INNER" || tv == "inner";
+		}
+
+		inline constexpr bool isleft(std::string_view const& tv) noexcept
+		{
+			return tv == "LEFT" || tv == "left";
+		}
+
+		inline constexpr bool isright(std::string_view const& tv) noexcept
+		{
+			return tv == "RIGHT" || tv == "right";
+		}
+
+		inline constexpr bool isfull(std::string_view const& tv) noexcept
+		{
+			return tv == "FULL" || tv == "full";
+		}
+
+		inline constexpr bool isouter(std::string_view const& tv) noexcept
+		{
+			return tv == "OUTER" || tv == "outer";
+		}
+
+		// join types which are followed by an ON clause
+		inline constexpr bool isequi(std::string_view const& tv) noexcept
+		{
+			return isinner(tv) || isleft(tv) || isright(tv) || isfull(tv);
+		}
+
+		inline constexpr bool ison(std::string_view const& tv) noexcept
+		{
+			return tv == "ON" || tv == "on";
+		}
+
 		inline constexpr bool iswhere(std::string_view const& tv) noexcept
 		{
 			return tv == "WHERE" || tv == "where";
@@ -141,104 +691,393 @@ namespace sql
 			return tv == "AS" || tv == "as";
 		}
 
-		inline constexpr bool isselect(std::string_view const& tv) noexcept
+		inline constexpr bool isgroup(std::string_view const& tv) noexcept
 		{
-			return tv == "SELECT" || tv == "select";
+			return tv == "GROUP" || tv == "group";
 		}
 
-		inline constexpr bool iscomma(std::string_view const& tv) noexcept
+		inline constexpr bool isby(std::string_view const& tv) noexcept
 		{
-			return tv == ",";
+			return tv == "BY" || tv == "by";
 		}
 
-		constexpr bool isintegral(std::string_view const& tv) noexcept
+		inline constexpr bool isorder(std::string_view const& tv) noexcept
 		{
-			bool result{ false };
+			return tv == "ORDER" || tv == "order";
+		}
 
-			for (auto c : tv)
-			{
-				result |= (c == '.');
-			}
+		inline constexpr bool isasc(std::string_view const& tv) noexcept
+		{
+			return tv == "ASC" || tv == "asc";
+		}
 
-			return !result;
+		inline constexpr bool isdesc(std::string_view const& tv) noexcept
+		{
+			return tv == "DESC" || tv == "desc";
 		}
 
-		constexpr bool isdigit(char c) noexcept
+		inline constexpr bool islimit(std::string_view const& tv) noexcept
 		{
-			return (c >= '0' && c <= '9') || c == '-' || c == '.';
+			return tv == "LIMIT" || tv == "limit";
 		}
 
-		constexpr bool iscomp(char c) noexcept
+		inline constexpr bool isoffset(std::string_view const& tv) noexcept
 		{
-			return c == '=' || c == '!' || c == '<' || c == '>';
+			return tv == "OFFSET" || tv == "offset";
 		}
 
-		constexpr bool iscolumn(std::string_view const& tv) noexcept
+		inline constexpr bool iscount(std::string_view const& tv) noexcept
 		{
-			return !iscomma(tv) && !isas(tv) && !isfrom(tv);
+			return tv == "COUNT" || tv == "count";
 		}
 
-		constexpr bool isseparator(std::string_view const& tv) noexcept
+		inline constexpr bool issum(std::string_view const& tv) noexcept
 		{
-			return iscomma(tv) || isfrom(tv);
+			return tv == "SUM" || tv == "sum";
 		}
 
-	} // namespace
+		inline constexpr bool isavg(std::string_view const& tv) noexcept
+		{
+			return tv == "AVG" || tv == "avg";
+		}
 
-	// structured binding compliant iterator for query objects
-	template <typename Expr>
-	class query_iterator
-	{
-	public:
-		using row_type = std::remove_cvref_t<typename Expr::output_type>;
+		inline constexpr bool ismin(std::string_view const& tv) noexcept
+		{
+			return tv == "MIN" || tv == "min";
+		}
 
-		// seeds row datamember for first dereference
-		query_iterator(bool end) : end_{ end }, row_{}
+		inline constexpr bool ismax(std::string_view const& tv) noexcept
 		{
-			operator++();
+			return tv == "MAX" || tv == "max";
 		}
 
-		inline bool operator==(query_iterator const& it) const noexcept
+		inline constexpr bool isaggregate(std::string_view const& tv) noexcept
 		{
-			return end_ == it.end_;
+			return iscount(tv) || issum(tv) || isavg(tv) || ismin(tv) || ismax(tv);
 		}
 
-		inline bool operator!=(query_iterator const& it) const noexcept
+		inline constexpr bool isselect(std::string_view const& tv) noexcept
 		{
-			return !(*this == it);
+			return tv == "SELECT" || tv == "select";
 		}
 
-		inline row_type const& operator*() const noexcept
+		inline constexpr bool iscomma(std::string_view const& tv) noexcept
 		{
-			return row_;
+			return tv == ",";
 		}
 
-		query_iterator& operator++()
+		// column name of a possibly schema qualified column token ("books.title" names "title")
+		constexpr std::string_view unqualified(std::string_view const& tv) noexcept
 		{
-			if (!end_)
-			{
-				try
+			auto const dot{ tv.rfind('.') };
+
+			return dot == std::string_view::npos ? tv : tv.substr(dot + 1);
+		}
+
+		// column name qualified with the name of its schema ("collected" and "title" name "collected.title")
+		template <cexpr::string Schema, cexpr::string Column>
+		constexpr auto qualify() noexcept
+		{
+			std::array<char, Schema.size() + Column.size() + 1> text{};
+
+			std::copy(Schema.cbegin(), Schema.cend(), text.begin());
+			text[Schema.size()] = '.';
+			std::copy(Column.cbegin(), Column.cend(), text.begin() + Schema.size() + 1);
+
+			return cexpr::string<char, text.size() + 1>{ std::string_view{ text.data(), text.size() } };
+		}
+
+		// Row with the columns sharing a name with a column of Shadow renamed to names qualified with Schema
+		template <cexpr::string Schema, typename Row, typename Shadow>
+		constexpr auto qualified()
+		{
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return sql::void_row{};
+			}
+			else
+			{
+				using next = decltype(qualified<Schema, typename Row::next, Shadow>());
+
+				if constexpr (sql::exists<Row::column::name, Shadow>())
 				{
-					row_ = Expr::next();
+					constexpr auto name{ qualify<Schema, Row::column::name>() };
+
+					return sql::row<sql::column<name, typename Row::column::type>, next>{};
 				}
-				catch (ra::data_end const& e)
+				else
 				{
-					end_ = true;
+					return sql::row<typename Row::column, next>{};
 				}
 			}
+		}
+
+		constexpr bool isintegral(std::string_view const& tv) noexcept
+		{
+			bool result{ false };
+
+			for (auto c : tv)
+			{
+				result |= (c == '.');
+			}
+
+			return !result;
+		}
+
+		// true when the token is an unsigned integer
+		constexpr bool isnumber(std::string_view const& tv) noexcept
+		{
+			bool result{ !tv.empty() };
+
+			for (auto c : tv)
+			{
+				result &= (c >= '0' && c <= '9');
+			}
+
+			return result;
+		}
+
+		// value of an unsigned integer token such as a row count
+		constexpr std::size_t tocount(std::string_view const& tv) noexcept
+		{
+			std::size_t acc{};
+
+			for (auto c : tv)
+			{
+				acc = acc * 10 + static_cast<std::size_t>(c - '0');
+			}
+
+			return acc;
+		}
+
+		constexpr bool isdigit(char c) noexcept
+		{
+			return (c >= '0' && c <= '9') || c == '-' || c == '.';
+		}
+
+		// the empty token closing the query is no operator, so a parenthesized predicate can end it
+		constexpr bool iscomp(std::string_view const& tv) noexcept
+		{
+			return !tv.empty() && (tv[0] == '=' || tv[0] == '!' || tv[0] == '<' || tv[0] == '>');
+		}
+
+		constexpr bool iscolumn(std::string_view const& tv) noexcept
+		{
+			return !iscomma(tv) && !isas(tv) && !isfrom(tv);
+		}
+
+		constexpr bool isseparator(std::string_view const& tv) noexcept
+		{
+			return iscomma(tv) || isfrom(tv);
+		}
+
+	} // namespace
+
+	// structured binding compliant iterator for query objects
+	template <typename Expr>
+	class query_iterator
+	{
+	public:
+		using row_type = std::remove_cvref_t<typename Expr::output_type>;
+
+		// fetches the first row, a null expression marks the end iterator
+		query_iterator(Expr* expr) : expr_{ expr }, row_{ expr == nullptr ? nullptr : expr->next() }
+		{}
+
+		inline bool operator==(query_iterator const& it) const noexcept
+		{
+			return (row_ == nullptr) == (it.row_ == nullptr);
+		}
+
+		inline bool operator!=(query_iterator const& it) const noexcept
+		{
+			return !(*this == it);
+		}
+
+		// the row is owned by the expression tree and stays valid until the iterator is incremented
+		inline row_type const& operator*() const noexcept
+		{
+			return *row_;
+		}
+
+		query_iterator& operator++()
+		{
+			if (row_ != nullptr)
+			{
+				row_ = expr_->next();
+			}
+
+			return *this;
+		}
+
+	private:
+		Expr* expr_{};
+		row_type const* row_{};
+	};
+
+	// view over a single batch of query output rows
+	template <typename Row>
+	class batch
+	{
+	public:
+		class iterator
+		{
+		public:
+			iterator(Row const* const* curr) : curr_{ curr }
+			{}
+
+			inline bool operator==(iterator const& it) const noexcept
+			{
+				return curr_ == it.curr_;
+			}
+
+			inline bool operator!=(iterator const& it) const noexcept
+			{
+				return !(*this == it);
+			}
+
+			inline Row const& operator*() const noexcept
+			{
+				return **curr_;
+			}
+
+			inline iterator& operator++() noexcept
+			{
+				++curr_;
+
+				return *this;
+			}
+
+		private:
+			Row const* const* curr_;
+		};
+
+		batch(std::span<Row const* const> rows) : rows_{ rows }
+		{}
+
+		inline std::size_t size() const noexcept
+		{
+			return rows_.size();
+		}
+
+		inline Row const& operator[](std::size_t i) const noexcept
+		{
+			return *rows_[i];
+		}
+
+		inline iterator begin() const noexcept
+		{
+			return iterator{ rows_.data() };
+		}
+
+		inline iterator end() const noexcept
+		{
+			return iterator{ rows_.data() + rows_.size() };
+		}
+
+	private:
+		std::span<Row const* const> rows_;
+	};
+
+	// iterator over batches of up to Size query output rows
+	template <typename Expr, std::size_t Size>
+	class batch_iterator
+	{
+	public:
+		using row_type = std::remove_cvref_t<typename Expr::output_type>;
+
+		// fills the first batch for dereference, a null expression marks the end iterator
+		batch_iterator(Expr* expr) : end_{ expr == nullptr }, expr_{ expr }, rows_(end_ ? 0 : Size), size_{}
+		{
+			operator++();
+		}
+
+		inline bool operator==(batch_iterator const& it) const noexcept
+		{
+			return end_ == it.end_;
+		}
+
+		inline bool operator!=(batch_iterator const& it) const noexcept
+		{
+			return !(*this == it);
+		}
+
+		inline batch<row_type> operator*() const noexcept
+		{
+			return batch<row_type>{ std::span{ rows_.data(), size_ } };
+		}
+
+		batch_iterator& operator++()
+		{
+			if (!end_)
+			{
+				size_ = expr_->next_batch(std::span{ rows_ });
+				end_ = size_ == 0;
+			}
 
 			return *this;
 		}
 
 	private:
 		bool end_{};
-		row_type row_{};
+		Expr* expr_{};
+		std::vector<row_type const*> rows_{};
+		std::size_t size_{};
 	};
 
-	template <cexpr::string Str, typename... Schemas>
-	class query
+	// range loop wrapper returned by query::batches
+	template <typename Expr, std::size_t Size>
+	class batch_range
 	{
+	public:
+		using iterator = batch_iterator<Expr, Size>;
+
+		batch_range(Expr* expr) : expr_{ expr }
+		{}
+
+		inline iterator begin() const
+		{
+			return iterator{ expr_ };
+		}
+
+		inline iterator end() const
+		{
+			return iterator{ nullptr };
+		}
+
 	private:
+		Expr* expr_;
+	};
+
+	// output order of query::parallel, schema order or the order chunks finish in
+	enum class merge
+	{
+		ordered,
+		unordered
+	};
+
+	// View selects rows of string views into the schema storage over rows of copied values
+	template <cexpr::string Str, bool View, typename... Schemas>
+	class basic_query
+	{
+	private:
+		// name of the possibly schema qualified column token at Pos in the Row rows, a qualified name is kept when the rows
+		//	carry a column of that name, which are the right columns a join qualified with their schema
+		template <std::size_t Pos, typename Row>
+		static constexpr std::string_view resolve() noexcept
+		{
+			constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+
+			if constexpr (sql::exists<name, Row>())
+			{
+				return tokens_[Pos];
+			}
+			else
+			{
+				return unqualified(tokens_[Pos]);
+			}
+		}
+
 		// where predicate terminal parsing 
 		template <std::size_t Pos, typename Row>
 		static constexpr auto parse_terms()
@@ -275,7 +1114,7 @@ namespace sql
 			}
 			else
 			{
-				constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+				constexpr cexpr::string<char, resolve<Pos, Row>().length() + 1> name{ resolve<Pos, Row>() };
 
 				using node = sql::variable<name, Row>;
 
@@ -287,7 +1126,7 @@ namespace sql
 		template <typename Left, typename Row>
 		static constexpr auto recurse_comparison()
 		{
-			if constexpr (!iscomp(tokens_[Left::pos][0]))
+			if constexpr (!iscomp(tokens_[Left::pos]))
 			{
 				return Left{};
 			}
@@ -387,13 +1226,57 @@ namespace sql
 			return recurse_or<left, Row>();
 		}
 
+		// true if any token names the column, is a wildcard other than the one of COUNT(*), or joins naturally on a leading column
+		template <cexpr::string Name, bool Leading>
+		static constexpr bool referenced() noexcept
+		{
+			std::string_view name{ Name.cbegin(), Name.size() };
+
+			for (std::size_t i{}; i < tokens_.count(); ++i)
+			{
+				bool const wildcard{ tokens_[i] == "*" && (i == 0 || tokens_[i - 1] != "(") };
+
+				if (unqualified(tokens_[i]) == name || wildcard || (Leading && isnatural(tokens_[i])))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// row of the columns in Row which are read by the query
+		template <typename Row, bool Leading = true>
+		static constexpr auto referenced_columns()
+		{
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return sql::void_row{};
+			}
+			else
+			{
+				using next = decltype(referenced_columns<typename Row::next, false>());
+
+				if constexpr (referenced<Row::column::name, Leading>())
+				{
+					return sql::row<typename Row::column, next>{};
+				}
+				else
+				{
+					return next{};
+				}
+			}
+		}
+
 		// find correct schema for terminal relation
 		template <cexpr::string Name, std::size_t Id, typename Schema, typename... Others>
 		static constexpr auto recurse_schemas()
 		{
 			if constexpr (Name == Schema::name)
 			{
-				return ra::relation<Schema, Id>{};
+				using columns = decltype(referenced_columns<typename Schema::row_type>());
+
+				return ra::relation<Schema, Id, columns>{};
 			}
 			else
 			{
@@ -419,48 +1302,578 @@ namespace sql
 			}
 			else
 			{
-				constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+				constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+
+				using node = decltype(recurse_schemas<name, Pos, Schemas...>());
+
+				return context<Pos + 1, node>{};
+			}
+		}
+
+		// hash joins of two scans build over whichever input holds fewer rows once seeded, the inputs
+		//	of other joins are not sized so their tables are built over the right input
+		template <typename Left, typename Right>
+		static constexpr ra::side build_side() noexcept
+		{
+			if constexpr (scan<Left>::value && scan<Right>::value)
+			{
+				return ra::side::smaller;
+			}
+			else
+			{
+				return ra::side::right;
+			}
+		}
+
+		// Row of the Right input with the columns sharing a name with a LeftCols column qualified with the name of the
+		//	schema Right scans, so a join keeps them beside the left columns, rows of other inputs keep their names
+		template <typename Right, typename LeftCols, typename Row = std::remove_cvref_t<typename Right::output_type>>
+		static constexpr auto qualified_row()
+		{
+			if constexpr (scan<Right>::value)
+			{
+				return qualified<scan<Right>::schema::name, Row, LeftCols>();
+			}
+			else
+			{
+				return Row{};
+			}
+		}
+
+		// Right renamed to its qualified row, inputs without a column to qualify are not renamed
+		template <typename Right, typename LeftCols>
+		static constexpr auto qualified_input()
+		{
+			using row = decltype(qualified_row<Right, LeftCols>());
+
+			if constexpr (std::is_same_v<row, std::remove_cvref_t<typename Right::output_type>>)
+			{
+				return Right{};
+			}
+			else
+			{
+				return ra::rename<row, Right>{};
+			}
+		}
+
+		// name the Name column of the Right input has in its qualified row
+		template <typename Right, typename LeftCols, cexpr::string Name>
+		static constexpr auto qualified_name()
+		{
+			if constexpr (scan<Right>::value && sql::exists<Name, LeftCols>())
+			{
+				return qualify<scan<Right>::schema::name, Name>();
+			}
+			else
+			{
+				return Name;
+			}
+		}
+
+		// stub which will choose the specific join RA node, the join only carries the columns the query reads,
+		//	inputs sorted on their join keys are merged and a right input indexed on its key is probed instead of hashed
+		template <std::size_t Pos, typename Left, typename Right>
+		static constexpr auto choose_join()
+		{
+			using lcols = decltype(referenced_columns<std::remove_cvref_t<typename Left::output_type>>());
+			using rcols = decltype(referenced_columns<std::remove_cvref_t<typename Right::output_type>>());
+
+			constexpr auto lkey{ std::remove_cvref_t<typename Left::output_type>::column::name };
+			constexpr auto rkey{ std::remove_cvref_t<typename Right::output_type>::column::name };
+
+			if constexpr (isnatural(tokens_[Pos]) && ordered<Left, lkey>() && ordered<Right, rkey>())
+			{
+				return ra::sorted<Left, Right, lkey, rkey, lcols, rcols>{};
+			}
+			else if constexpr (isnatural(tokens_[Pos]) && seekable<Right>::value && ordered<Right, rkey>())
+			{
+				return ra::indexed<Left, Right, lkey, rkey, lcols, rcols>{};
+			}
+			else if constexpr (isnatural(tokens_[Pos]))
+			{
+				return ra::natural<Left, Right, lcols, rcols, build_side<Left, Right>()>{};
+			}
+			else
+			{
+				using right = decltype(qualified_input<Right, lcols>());
+
+				return ra::cross<Left, right, lcols, decltype(qualified_row<Right, lcols, rcols>())>{};
+			}
+		}
+
+		// true when the ON clause column at Pos is qualified with the name of the schema Node scans
+		template <std::size_t Pos, typename Node>
+		static constexpr bool qualifies()
+		{
+			if constexpr (scan<Node>::value)
+			{
+				constexpr auto name{ scan<Node>::schema::name };
+				constexpr auto column{ tokens_[Pos] };
+
+				return column.size() > name.size() && column[name.size()] == '.' && column.substr(0, name.size()) == std::string_view{ name.cbegin(), name.size() };
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		// inner joins merge inputs sorted on their keys, probe a right input indexed on its key, or otherwise hash the right input
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		static constexpr auto choose_inner()
+		{
+			if constexpr (ordered<Left, LeftKey>() && ordered<Right, RightKey>())
+			{
+				return ra::sorted<Left, Right, LeftKey, RightKey, LeftCols, RightCols>{};
+			}
+			else if constexpr (seekable<Right>::value && ordered<Right, RightKey>())
+			{
+				return ra::indexed<Left, Right, LeftKey, RightKey, LeftCols, RightCols>{};
+			}
+			else
+			{
+				return ra::inner<Left, Right, LeftKey, RightKey, LeftCols, RightCols, build_side<Left, Right>()>{};
+			}
+		}
+
+		// outer joins hash their inputs and keep the right columns sharing a name with a left column under their qualified
+		//	names, as a padded column and the one of the same name hold different values, inner joins are chosen by choose_inner
+		template <std::size_t Kind, typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		static constexpr auto choose_equi()
+		{
+			using right = decltype(qualified_input<Right, LeftCols>());
+			using rcols = decltype(qualified_row<Right, LeftCols, RightCols>());
+
+			constexpr auto rkey{ qualified_name<Right, LeftCols, RightKey>() };
+
+			if constexpr (isleft(tokens_[Kind]))
+			{
+				return ra::outer<Left, right, LeftKey, rkey, LeftCols, rcols, ra::keep::left>{};
+			}
+			else if constexpr (isright(tokens_[Kind]))
+			{
+				return ra::outer<Left, right, LeftKey, rkey, LeftCols, rcols, ra::keep::right>{};
+			}
+			else if constexpr (isfull(tokens_[Kind]))
+			{
+				return ra::outer<Left, right, LeftKey, rkey, LeftCols, rcols, ra::keep::both>{};
+			}
+			else
+			{
+				return choose_inner<Left, Right, LeftKey, RightKey, LeftCols, RightCols>();
+			}
+		}
+
+		// parses the ON clause equality at Pos into a join of the kind named at Kind keyed on the named column of each input
+		template <std::size_t Pos, std::size_t Kind, typename Left, typename Right>
+		static constexpr auto parse_on()
+		{
+			static_assert(Pos + 3 < tokens_.count() && ison(tokens_[Pos]), "Expected 'ON' token following joined schema.");
+			static_assert(tokens_[Pos + 2] == "=", "Expected '=' between columns of the ON clause.");
+
+			constexpr cexpr::string<char, unqualified(tokens_[Pos + 1]).length() + 1> first{ unqualified(tokens_[Pos + 1]) };
+			constexpr cexpr::string<char, unqualified(tokens_[Pos + 3]).length() + 1> second{ unqualified(tokens_[Pos + 3]) };
+
+			using lrow = std::remove_cvref_t<typename Left::output_type>;
+			using rrow = std::remove_cvref_t<typename Right::output_type>;
+			using lcols = decltype(referenced_columns<lrow>());
+			using rcols = decltype(referenced_columns<rrow>());
+
+			constexpr bool forward{ sql::exists<first, lrow>() && sql::exists<second, rrow>() };
+			constexpr bool backward{ sql::exists<second, lrow>() && sql::exists<first, rrow>() };
+
+			static_assert(forward || backward, "ON clause must compare a column of each joined input.");
+
+			// columns present in both inputs are placed by their schema qualifier
+			if constexpr (forward && !(backward && qualifies<Pos + 1, Right>()))
+			{
+				return context<Pos + 4, decltype(choose_equi<Kind, Left, Right, first, second, lcols, rcols>())>{};
+			}
+			else
+			{
+				return context<Pos + 4, decltype(choose_equi<Kind, Left, Right, second, first, lcols, rcols>())>{};
+			}
+		}
+
+		// true when every column Predicate reads from Row belongs to Side and is not hidden by Shadow, a void Side reads nothing
+		template <typename Predicate, typename Row, typename Side, typename Shadow>
+		static constexpr bool readable()
+		{
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return !std::is_same_v<Side, sql::void_row>;
+			}
+			else if constexpr (Predicate::template reads<Row::column::name>() && (!sql::exists<Row::column::name, Side>() || sql::exists<Row::column::name, Shadow>()))
+			{
+				return false;
+			}
+			else
+			{
+				return readable<Predicate, typename Row::next, Side, Shadow>();
+			}
+		}
+
+		// conjunction of two predicates over Row where void stands for no predicate
+		template <typename Row, typename Left, typename Right>
+		static constexpr auto conjoin()
+		{
+			if constexpr (std::is_void_v<Left>)
+			{
+				return std::type_identity<Right>{};
+			}
+			else if constexpr (std::is_void_v<Right>)
+			{
+				return std::type_identity<Left>{};
+			}
+			else
+			{
+				return std::type_identity<sql::operation<"AND", Row, Left, Right>>{};
+			}
+		}
+
+		// top level AND conjuncts of Predicate which can be evaluated over Side, rebound to its rows
+		template <typename Predicate, typename Row, typename Side, typename Shadow>
+		static constexpr auto pushdown()
+		{
+			if constexpr (conjunction<Predicate>::value)
+			{
+				using left = typename decltype(pushdown<typename conjunction<Predicate>::left, Row, Side, Shadow>())::type;
+				using right = typename decltype(pushdown<typename conjunction<Predicate>::right, Row, Side, Shadow>())::type;
+
+				return conjoin<Side, left, right>();
+			}
+			else if constexpr (readable<Predicate, Row, Side, Shadow>())
+			{
+				return std::type_identity<typename Predicate::template rebind<Side>>{};
+			}
+			else
+			{
+				return std::type_identity<void>{};
+			}
+		}
+
+		// top level AND conjuncts of Predicate which neither join input can evaluate
+		template <typename Predicate, typename Row, typename Left, typename Right, typename Shadow>
+		static constexpr auto residual()
+		{
+			if constexpr (conjunction<Predicate>::value)
+			{
+				using left = typename decltype(residual<typename conjunction<Predicate>::left, Row, Left, Right, Shadow>())::type;
+				using right = typename decltype(residual<typename conjunction<Predicate>::right, Row, Left, Right, Shadow>())::type;
+
+				return conjoin<Row, left, right>();
+			}
+			else if constexpr (readable<Predicate, Row, Left, sql::void_row>() || readable<Predicate, Row, Right, Shadow>())
+			{
+				return std::type_identity<void>{};
+			}
+			else
+			{
+				return std::type_identity<Predicate>{};
+			}
+		}
+
+		// true when Column is read from Side in the rows of a join, a right column of the same name as a
+		//	left column is hidden by it, and its values are never null so hashing them matches sql equality
+		template <cexpr::string Column, typename Side, typename Shadow>
+		static constexpr bool keyable() noexcept
+		{
+			if constexpr (sql::exists<Column, Side>() && !sql::exists<Column, Shadow>())
+			{
+				return !nullable_type<std::remove_cvref_t<decltype(sql::get<Column>(Side{}))>>::value;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		// LeftKey and RightKey hash together when they are keys of their inputs with the same type
+		template <cexpr::string LeftKey, cexpr::string RightKey, typename Left, typename Right, typename Shadow>
+		static constexpr bool hashable() noexcept
+		{
+			if constexpr (keyable<LeftKey, Left, sql::void_row>() && keyable<RightKey, Right, Shadow>())
+			{
+				using left = std::remove_cvref_t<decltype(sql::get<LeftKey>(Left{}))>;
+				using right = std::remove_cvref_t<decltype(sql::get<RightKey>(Right{}))>;
+
+				return std::is_same_v<left, right>;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		// first top level AND conjunct of Predicate equating a column of Left with a column of Right, or void
+		template <typename Predicate, typename Left, typename Right, typename Shadow>
+		static constexpr auto equate()
+		{
+			if constexpr (conjunction<Predicate>::value)
+			{
+				using left = typename decltype(equate<typename conjunction<Predicate>::left, Left, Right, Shadow>())::type;
+
+				if constexpr (std::is_void_v<left>)
+				{
+					return equate<typename conjunction<Predicate>::right, Left, Right, Shadow>();
+				}
+				else
+				{
+					return std::type_identity<left>{};
+				}
+			}
+			else if constexpr (!equality<Predicate>::value)
+			{
+				return std::type_identity<void>{};
+			}
+			else if constexpr (hashable<equality<Predicate>::left, equality<Predicate>::right, Left, Right, Shadow>())
+			{
+				return std::type_identity<keyed<equality<Predicate>::left, equality<Predicate>::right, Predicate>>{};
+			}
+			else if constexpr (hashable<equality<Predicate>::right, equality<Predicate>::left, Left, Right, Shadow>())
+			{
+				return std::type_identity<keyed<equality<Predicate>::right, equality<Predicate>::left, Predicate>>{};
+			}
+			else
+			{
+				return std::type_identity<void>{};
+			}
+		}
+
+		// Predicate over Row without its top level AND conjuncts of type Conjunct, void when none remain
+		template <typename Predicate, typename Row, typename Conjunct>
+		static constexpr auto drop()
+		{
+			if constexpr (conjunction<Predicate>::value)
+			{
+				using left = typename decltype(drop<typename conjunction<Predicate>::left, Row, Conjunct>())::type;
+				using right = typename decltype(drop<typename conjunction<Predicate>::right, Row, Conjunct>())::type;
+
+				return conjoin<Row, left, right>();
+			}
+			else if constexpr (std::is_same_v<Predicate, Conjunct>)
+			{
+				return std::type_identity<void>{};
+			}
+			else
+			{
+				return std::type_identity<Predicate>{};
+			}
+		}
+
+		// a cross join filtered on the equality of a column of each input is joined on those columns instead, the
+		//	rest of the predicate is placed over the equi join, void when Node is no such cross join
+		template <typename Predicate, typename Node>
+		static constexpr auto rehash()
+		{
+			if constexpr (product<Node>::value)
+			{
+				using inputs = product<Node>;
+				using row = std::remove_cvref_t<typename Node::output_type>;
+				using lrow = std::remove_cvref_t<typename inputs::left::output_type>;
+				using rrow = std::remove_cvref_t<typename inputs::right::output_type>;
+
+				using keys = typename decltype(equate<Predicate, lrow, rrow, typename inputs::left_columns>())::type;
+
+				if constexpr (std::is_void_v<keys>)
+				{
+					return std::type_identity<void>{};
+				}
+				else
+				{
+					using join = decltype(choose_inner<typename inputs::left, typename inputs::right, keys::left_key, keys::right_key,
+						typename inputs::left_columns, typename inputs::right_columns>());
+					using rest = typename decltype(drop<Predicate, row, typename keys::conjunct>())::type;
+
+					return std::type_identity<decltype(parse_selection<rest, join>())>{};
+				}
+			}
+			else
+			{
+				return std::type_identity<void>{};
+			}
+		}
+
+		// places a selection over Node, pushing conjuncts below joins to the inputs which own their columns
+		template <typename Predicate, typename Node>
+		static constexpr auto parse_selection()
+		{
+			if constexpr (std::is_void_v<Predicate>)
+			{
+				return Node{};
+			}
+			else if constexpr (!std::is_void_v<typename decltype(rehash<Predicate, Node>())::type>)
+			{
+				return typename decltype(rehash<Predicate, Node>())::type{};
+			}
+			else if constexpr (join_inputs<Node>::value)
+			{
+				using inputs = join_inputs<Node>;
+				using row = std::remove_cvref_t<typename Node::output_type>;
+				using lrow = std::conditional_t<padding<Node>::left, sql::void_row, std::remove_cvref_t<typename inputs::left::output_type>>;
+				using rrow = std::conditional_t<padding<Node>::right, sql::void_row, std::remove_cvref_t<typename inputs::right::output_type>>;
+
+				using lpred = typename decltype(pushdown<Predicate, row, lrow, sql::void_row>())::type;
+				using rpred = typename decltype(pushdown<Predicate, row, rrow, typename inputs::shadow>())::type;
+				using rest = typename decltype(residual<Predicate, row, lrow, rrow, typename inputs::shadow>())::type;
+
+				using lnode = decltype(parse_selection<lpred, typename inputs::left>());
+				using rnode = decltype(parse_selection<rpred, typename inputs::right>());
+
+				using join = typename inputs::template rebuild<lnode, rnode>;
+
+				if constexpr (std::is_void_v<rest>)
+				{
+					return join{};
+				}
+				else
+				{
+					return ra::selection<rest, join>{};
+				}
+			}
+			else
+			{
+				return ra::selection<Predicate, Node>{};
+			}
+		}
+
+		// one past the JOIN keyword of a JOIN, INNER JOIN, or LEFT, RIGHT, and FULL [OUTER] JOIN clause starting at pos
+		static constexpr std::size_t join_end(std::size_t pos) noexcept
+		{
+			if (isjoin(tokens_[pos]))
+			{
+				return pos + 1;
+			}
+			else if (isouter(tokens_[pos + 1]))
+			{
+				return pos + 3;
+			}
+			else
+			{
+				return pos + 2;
+			}
+		}
+
+		// recursively parses the joins chained onto Left into a left deep join tree in written order
+		template <typename Left>
+		static constexpr auto recurse_join()
+		{
+			using lnode = typename Left::node;
+
+			if constexpr (Left::pos + 2 < tokens_.count() && isjoin(tokens_[Left::pos + 1]) && !isequi(tokens_[Left::pos]))
+			{
+				constexpr auto rnext{ parse_schema<Left::pos + 2>() };
+
+				using rnode = typename decltype(rnext)::node;
+				using join = decltype(choose_join<Left::pos, lnode, rnode>());
+
+				return recurse_join<context<rnext.pos, join>>();
+			}
+			else if constexpr (Left::pos + 1 < tokens_.count() && (isjoin(tokens_[Left::pos]) || isequi(tokens_[Left::pos])))
+			{
+				constexpr std::size_t rpos{ join_end(Left::pos) };
+
+				static_assert(isjoin(tokens_[rpos - 1]), "Expected 'JOIN' token following the join type.");
+
+				constexpr auto rnext{ parse_schema<rpos>() };
+
+				using rnode = typename decltype(rnext)::node;
+
+				return recurse_join<decltype(parse_on<rnext.pos, Left::pos, lnode, rnode>())>();
+			}
+			else
+			{
+				return Left{};
+			}
+		}
+
+		// parses the first relation and the joins chained onto it, else returns the single relation terminal
+		template <std::size_t Pos>
+		static constexpr auto parse_join()
+		{
+			constexpr auto lnext{ parse_schema<Pos>() };
+
+			return recurse_join<context<lnext.pos, typename decltype(lnext)::node>>();
+		}
+
+		// columns the relations of Relations carry into the joins over them
+		template <typename Relations, std::size_t Id = 0>
+		static constexpr std::size_t carried() noexcept
+		{
+			if constexpr (Id == std::tuple_size_v<Relations>)
+			{
+				return 0;
+			}
+			else
+			{
+				using row = std::remove_cvref_t<typename std::tuple_element_t<Id, Relations>::output_type>;
+
+				return decltype(referenced_columns<row>())::depth + carried<Relations, Id + 1>();
+			}
+		}
+
+		// joins the relations of Chain onto Node in its planned order from Step on, keying each join on the
+		//	columns of the link which joins the relation to the ones before it
+		template <typename Chain, std::size_t Step, typename Node>
+		static constexpr auto rejoin()
+		{
+			if constexpr (Step == Chain::size)
+			{
+				return Node{};
+			}
+			else
+			{
+				constexpr auto plan{ Chain::order() };
 
-				using node = decltype(recurse_schemas<name, Pos, Schemas...>());
+				using right = std::tuple_element_t<plan.ids[Step], typename Chain::relations>;
+				using link = std::tuple_element_t<plan.links[Step], typename Chain::links>;
+				using lcols = decltype(referenced_columns<std::remove_cvref_t<typename Node::output_type>>());
+				using rcols = decltype(referenced_columns<std::remove_cvref_t<typename right::output_type>>());
 
-				return context<Pos + 1, node>{};
+				if constexpr (link::right_id == plan.ids[Step])
+				{
+					return rejoin<Chain, Step + 1, decltype(choose_inner<Node, right, link::left_key, link::right_key, lcols, rcols>())>();
+				}
+				else
+				{
+					return rejoin<Chain, Step + 1, decltype(choose_inner<Node, right, link::right_key, link::left_key, lcols, rcols>())>();
+				}
 			}
 		}
 
-		// stub which will choose the specific join RA node
-		template <std::size_t Pos, typename Left, typename Right>
-		static constexpr auto choose_join()
+		// joins chains of three or more inner equi joins over hinted schemas smallest relation first, chains whose
+		//	relations share column names the links do not equate keep their order as the shared column would change
+		template <typename Node>
+		static constexpr auto reorder()
 		{
-			if constexpr (isnatural(tokens_[Pos]))
+			using chain = decltype(flatten<Node>());
+			using row = std::remove_cvref_t<typename Node::output_type>;
+
+			if constexpr (chain::size > 2 && chain::hinted && chain::typed && carried<typename chain::relations>() == row::depth + chain::equated && chain::reordered())
 			{
-				return ra::natural<Left, Right>{};
+				constexpr auto plan{ chain::order() };
+
+				return rejoin<chain, 1, std::tuple_element_t<plan.ids[0], typename chain::relations>>();
 			}
 			else
 			{
-				return ra::cross<Left, Right>{};	
+				return Node{};
 			}
 		}
 
-		// parses join colinfo if a join is present else returns the single relation terminal
-		template <std::size_t Pos>
-		static constexpr auto parse_join()
+		// projects a reordered join tree back to the column order of the written one when the query selects *
+		template <std::size_t Pos, typename Written, typename Node>
+		static constexpr auto restore()
 		{
-			constexpr auto lnext{ parse_schema<Pos>() };
-
-			using lnode = typename decltype(lnext)::node;
+			using row = std::remove_cvref_t<typename Written::output_type>;
 
-			if constexpr (lnext.pos + 2 < tokens_.count() && isjoin(tokens_[lnext.pos + 1]))
+			if constexpr (tokens_[Pos - 1] == "*" && !std::is_same_v<row, std::remove_cvref_t<typename Node::output_type>>)
 			{
-				constexpr auto rnext{ parse_schema<lnext.pos + 2>() };
-
-				using rnode = typename decltype(rnext)::node;
-				using join = decltype(choose_join<lnext.pos, lnode, rnode>());
-
-				return context<rnext.pos, join>{};
+				return ra::projection<row, Node>{};
 			}
 			else
 			{
-				return context<lnext.pos, lnode>{};
+				return Node{};
 			}
 		}
 
@@ -472,7 +1885,8 @@ namespace sql
 
 			constexpr auto next{ parse_join<Pos + 1>() };
 
-			using node = typename decltype(next)::node;
+			using written = typename decltype(next)::node;
+			using node = decltype(reorder<written>());
 
 			if constexpr (next.pos < tokens_.count() && iswhere(tokens_[next.pos]))
 			{
@@ -481,13 +1895,13 @@ namespace sql
 				constexpr auto predicate{ parse_or<next.pos + 1, output>() };
 
 				using pnext = typename decltype(predicate)::node;
-				using snode = ra::selection<pnext, node>;
+				using snode = decltype(parse_selection<pnext, node>());
 
-				return context<predicate.pos, snode>{};
+				return context<predicate.pos, decltype(restore<Pos, written, snode>())>{};
 			}
 			else
 			{
-				return context<next.pos, node>{};	
+				return context<next.pos, decltype(restore<Pos, written, node>())>{};	
 			}
 		}
 
@@ -507,13 +1921,36 @@ namespace sql
 			}
 		}
 
-		// wrapper to determine the type for the the column
-		template <std::size_t Pos>
+		// type of the Name column in the Source rows, or in the schemas when Source lacks it
+		template <cexpr::string Name, typename Source>
+		static constexpr auto source_type()
+		{
+			if constexpr (sql::exists<Name, Source>())
+			{
+				return std::remove_cvref_t<decltype(sql::get<Name>(Source{}))>{};
+			}
+			else
+			{
+				return recurse_types<Name, Schemas...>();
+			}
+		}
+
+		// wrapper to determine the type for the the column, columns of the Source rows keep their type so outer joins project nulls
+		template <std::size_t Pos, typename Source>
 		static constexpr auto column_type()
 		{
-			constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+			constexpr cexpr::string<char, resolve<Pos, Source>().length() + 1> name{ resolve<Pos, Source>() };
+
+			using type = decltype(source_type<name, Source>());
 
-			return recurse_types<name, Schemas...>();
+			if constexpr (View)
+			{
+				return view_type<type>();
+			}
+			else
+			{
+				return type{};
+			}
 		}
 
 		// asserts token is column separator, and if comma returns one past the comma else start position
@@ -532,14 +1969,14 @@ namespace sql
 			}
 		}
 
-		template <std::size_t Pos, bool Rename>
+		template <std::size_t Pos, bool Rename, typename Source>
 		static constexpr auto parse_colinfo()
 		{
 			static_assert(iscolumn(tokens_[Pos]), "Invalid token starting column delcaration.");
 
 			constexpr bool rename{ isas(tokens_[Pos + 1]) && iscolumn(tokens_[Pos + 2]) };
 
-			using col = decltype(column_type<Pos>());
+			using col = decltype(column_type<Pos, Source>());
 
 			if constexpr (Rename && rename)
 			{
@@ -562,7 +1999,7 @@ namespace sql
 		}
 
 		// recursively parse all columns projected/renamed in the query
-		template <std::size_t Pos, bool Rename>
+		template <std::size_t Pos, bool Rename, typename Source>
 		static constexpr auto recurse_columns()
 		{
 			if constexpr (isfrom(tokens_[Pos]))
@@ -571,9 +2008,9 @@ namespace sql
 			}
 			else
 			{
-				constexpr auto info{ parse_colinfo<Pos, Rename>() };
-				constexpr cexpr::string<char, tokens_[info.name].length() + 1> name{ tokens_[info.name] };
-				constexpr auto child{ recurse_columns<info.next, Rename>() };
+				constexpr auto info{ parse_colinfo<Pos, Rename, Source>() };
+				constexpr cexpr::string<char, resolve<info.name, Source>().length() + 1> name{ resolve<info.name, Source>() };
+				constexpr auto child{ recurse_columns<info.next, Rename, Source>() };
 
 				using next = std::remove_const_t<typename decltype(child)::node>;
 				using col = std::remove_const_t<decltype(sql::column<name, typename decltype(info)::type>{})>;
@@ -583,12 +2020,26 @@ namespace sql
 			}
 		}
 
-		// wrapper to parse columns as a projection RA node
+		// position of the FROM keyword closing the column list starting at pos
+		static constexpr std::size_t find_from(std::size_t pos) noexcept
+		{
+			while (!isfrom(tokens_[pos]))
+			{
+				++pos;
+			}
+
+			return pos;
+		}
+
+		// wrapper to parse columns as a projection RA node, the input is parsed first so the columns take its types
 		template <std::size_t Pos>
 		static constexpr auto parse_projection()
 		{
-			constexpr auto proj{ recurse_columns<Pos, false>() };
-			constexpr auto next{ parse_from<proj.pos>() };
+			constexpr auto next{ parse_from<find_from(Pos)>() };
+
+			using source = std::remove_cvref_t<typename decltype(next)::node::output_type>;
+
+			constexpr auto proj{ recurse_columns<Pos, false, source>() };
 
 			using ranode = typename decltype(proj)::node;
 			using node = ra::projection<ranode, typename decltype(next)::node>;
@@ -602,7 +2053,8 @@ namespace sql
 		{
 			constexpr auto next = parse_projection<Pos>();
 
-			using ranode = typename decltype(recurse_columns<Pos, true>())::node;
+			using source = std::remove_cvref_t<typename decltype(next)::node::output_type>;
+			using ranode = typename decltype(recurse_columns<Pos, true, source>())::node;
 			using node = ra::rename<ranode, typename decltype(next)::node>;
 
 			return context<next.pos, node>{};
@@ -637,13 +2089,301 @@ namespace sql
 			}
 		}
 
+		// text of the tokens from first up to last as written in the query
+		static constexpr std::string_view spelling(std::size_t first, std::size_t last) noexcept
+		{
+			auto const begin{ tokens_[first].data() };
+			auto const end{ tokens_[last - 1].data() + tokens_[last - 1].size() };
+
+			return std::string_view{ begin, static_cast<std::size_t>(end - begin) };
+		}
+
+		// true when the FROM clause of the select list starting at Pos is followed by a GROUP BY clause
+		template <std::size_t Pos>
+		static constexpr bool grouped()
+		{
+			constexpr auto next{ parse_from<find_from(Pos)>() };
+
+			return next.pos + 1 < tokens_.count() && isgroup(tokens_[next.pos]) && isby(tokens_[next.pos + 1]);
+		}
+
+		// true when the select list starting at Pos calls an aggregate function, the only parentheses a select list holds
+		static constexpr bool aggregated(std::size_t pos) noexcept
+		{
+			for (; !isfrom(tokens_[pos]); ++pos)
+			{
+				if (tokens_[pos] == "(")
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// row of the Source columns named by the GROUP BY list starting at Pos
+		template <std::size_t Pos, typename Source>
+		static constexpr auto recurse_keys()
+		{
+			constexpr cexpr::string<char, resolve<Pos, Source>().length() + 1> name{ resolve<Pos, Source>() };
+
+			static_assert(sql::exists<name, Source>(), "GROUP BY column was not present in the grouped rows.");
+
+			using col = sql::column<name, std::remove_cvref_t<decltype(sql::get<name>(Source{}))>>;
+
+			if constexpr (Pos + 1 < tokens_.count() && iscomma(tokens_[Pos + 1]))
+			{
+				constexpr auto child{ recurse_keys<Pos + 2, Source>() };
+
+				return context<child.pos, sql::row<col, typename decltype(child)::node>>{};
+			}
+			else
+			{
+				return context<Pos + 1, sql::row<col, sql::void_row>>{};
+			}
+		}
+
+		// aggregate function at Pos over the Name column of the Source rows, its result may be null when a group can
+		//	hold no value of the column, which are the groups of nullable columns and the one group of a query without GROUP BY
+		template <std::size_t Pos, cexpr::string Name, typename Source, typename Keys>
+		static constexpr auto choose_aggregate()
+		{
+			using type = std::remove_cvref_t<decltype(sql::get<Name>(Source{}))>;
+
+			constexpr bool nullable{ Keys::depth == 0 || nullable_type<type>::value };
+
+			if constexpr (issum(tokens_[Pos]))
+			{
+				return sql::sum<Name, type, nullable>{};
+			}
+			else if constexpr (isavg(tokens_[Pos]))
+			{
+				return sql::avg<Name, type, nullable>{};
+			}
+			else if constexpr (ismin(tokens_[Pos]))
+			{
+				return sql::min<Name, type, nullable>{};
+			}
+			else
+			{
+				return sql::max<Name, type, nullable>{};
+			}
+		}
+
+		// parses the select list item at Pos of a grouped query into the aggregate computing it from the Source rows of a group
+		template <std::size_t Pos, typename Source, typename Keys>
+		static constexpr auto parse_aggregate()
+		{
+			if constexpr (tokens_[Pos + 1] == "(")
+			{
+				static_assert(isaggregate(tokens_[Pos]), "Aggregate functions are COUNT, SUM, AVG, MIN, and MAX.");
+				static_assert(tokens_[Pos + 3] == ")", "Expected ')' closing the aggregate function.");
+
+				constexpr cexpr::string<char, resolve<Pos + 2, Source>().length() + 1> name{ resolve<Pos + 2, Source>() };
+
+				static_assert((iscount(tokens_[Pos]) && name == "*") || sql::exists<name, Source>(), "Aggregated column was not present in the aggregated rows.");
+
+				if constexpr (iscount(tokens_[Pos]))
+				{
+					return context<Pos + 4, sql::count<name>>{};
+				}
+				else
+				{
+					return context<Pos + 4, decltype(choose_aggregate<Pos, name, Source, Keys>())>{};
+				}
+			}
+			else
+			{
+				constexpr cexpr::string<char, resolve<Pos, Keys>().length() + 1> name{ resolve<Pos, Keys>() };
+
+				static_assert(sql::exists<name, Keys>(), "Columns selected alongside aggregates must be GROUP BY columns.");
+
+				return context<Pos + 1, sql::grouped<name, std::remove_cvref_t<decltype(sql::get<name>(Keys{}))>>>{};
+			}
+		}
+
+		// recursively parses the select list of a grouped query, a column is named by its alias or else by its text as written
+		template <std::size_t Pos, typename Source, typename Keys>
+		static constexpr auto recurse_aggregates()
+		{
+			if constexpr (isfrom(tokens_[Pos]))
+			{
+				return selects<sql::void_row, std::tuple<>>{};
+			}
+			else
+			{
+				constexpr auto item{ parse_aggregate<Pos, Source, Keys>() };
+				constexpr bool rename{ isas(tokens_[item.pos]) };
+
+				static_assert(!rename || iscolumn(tokens_[item.pos + 1]), "Expected column name following 'AS' token.");
+
+				constexpr std::string_view text{ rename ? tokens_[item.pos + 1] : spelling(Pos, item.pos) };
+				constexpr cexpr::string<char, text.length() + 1> name{ text };
+
+				using aggregate = typename decltype(item)::node;
+				using col = sql::column<name, typename aggregate::type>;
+				using next = decltype(recurse_aggregates<next_column<rename ? item.pos + 2 : item.pos>(), Source, Keys>());
+				using aggregates = decltype(std::tuple_cat(std::tuple<aggregate>{}, typename next::aggregates{}));
+
+				return selects<sql::row<col, typename next::output>, aggregates>{};
+			}
+		}
+
+		// GROUP BY clause following the FROM clause ending at Pos, a query with aggregates and no GROUP BY has no keys
+		template <std::size_t Pos, typename Source>
+		static constexpr auto parse_keys()
+		{
+			if constexpr (Pos + 1 < tokens_.count() && isgroup(tokens_[Pos]) && isby(tokens_[Pos + 1]))
+			{
+				return recurse_keys<Pos + 2, Source>();
+			}
+			else
+			{
+				return context<Pos, sql::void_row>{};
+			}
+		}
+
+		// parses the select list of a query with a GROUP BY clause or aggregates into an aggregation over the rows
+		//	of its FROM clause, so only the aggregated rows leave the expression tree, rows which arrive ordered on
+		//	their one GROUP BY column are aggregated as they stream by and the rest by a hash aggregation
+		template <std::size_t Pos>
+		static constexpr auto parse_group()
+		{
+			constexpr auto next{ parse_from<find_from(Pos)>() };
+
+			using input = typename decltype(next)::node;
+			using source = std::remove_cvref_t<typename input::output_type>;
+
+			constexpr auto keys{ parse_keys<next.pos, source>() };
+
+			using row = typename decltype(keys)::node;
+			using cols = decltype(recurse_aggregates<Pos, source, row>());
+			using node = std::conditional_t<streamable<input, row>(),
+				ra::streamed<typename cols::output, row, typename cols::aggregates, input>,
+				ra::group<typename cols::output, row, typename cols::aggregates, input>>;
+
+			return context<keys.pos, node>{};
+		}
+
+		// recursively parses the ORDER BY list starting at Pos over the Row columns, an aggregate is named by its text as written
+		template <std::size_t Pos, typename Row>
+		static constexpr auto recurse_order()
+		{
+			constexpr bool call{ Pos + 1 < tokens_.count() && tokens_[Pos + 1] == "(" };
+			constexpr std::size_t next{ call ? Pos + 4 : Pos + 1 };
+			constexpr std::string_view text{ call ? spelling(Pos, next) : resolve<Pos, Row>() };
+			constexpr cexpr::string<char, text.length() + 1> name{ text };
+
+			static_assert(sql::exists<name, Row>(), "ORDER BY column was not present in the selected rows.");
+
+			constexpr bool desc{ next < tokens_.count() && isdesc(tokens_[next]) };
+			constexpr std::size_t end{ next < tokens_.count() && (desc || isasc(tokens_[next])) ? next + 1 : next };
+
+			using col = sql::direction<name, desc>;
+
+			if constexpr (end < tokens_.count() && iscomma(tokens_[end]))
+			{
+				constexpr auto child{ recurse_order<end + 1, Row>() };
+
+				return context<child.pos, decltype(prepend<col>(typename decltype(child)::node{}))>{};
+			}
+			else
+			{
+				return context<end, sql::order<col>>{};
+			}
+		}
+
+		// LIMIT clause at Pos, a query without one outputs every row
+		template <std::size_t Pos>
+		static constexpr auto parse_limit()
+		{
+			if constexpr (Pos + 1 < tokens_.count() && islimit(tokens_[Pos]))
+			{
+				static_assert(isnumber(tokens_[Pos + 1]), "Expected row count following 'LIMIT' token.");
+
+				if constexpr (Pos + 3 < tokens_.count() && isoffset(tokens_[Pos + 2]))
+				{
+					static_assert(isnumber(tokens_[Pos + 3]), "Expected row count following 'OFFSET' token.");
+
+					return bounds<Pos + 4, tocount(tokens_[Pos + 1]), tocount(tokens_[Pos + 3])>{};
+				}
+				else
+				{
+					return bounds<Pos + 2, tocount(tokens_[Pos + 1]), 0>{};
+				}
+			}
+			else
+			{
+				return bounds<Pos, ra::unlimited, 0>{};
+			}
+		}
+
+		// ORDER BY and LIMIT clauses following the select statement ending at Pos, ordered rows are sorted by a top-k node
+		//	which only keeps the rows up to the last one the LIMIT clause outputs, and a limit node stops pulling rows once
+		//	the LIMIT clause is satisfied
+		template <std::size_t Pos, typename Node>
+		static constexpr auto parse_order()
+		{
+			constexpr bool order{ Pos + 1 < tokens_.count() && isorder(tokens_[Pos]) && isby(tokens_[Pos + 1]) };
+
+			if constexpr (order)
+			{
+				using row = std::remove_cvref_t<typename Node::output_type>;
+
+				constexpr auto clause{ recurse_order<Pos + 2, row>() };
+				constexpr auto limit{ parse_limit<clause.pos>() };
+				constexpr std::size_t kept{ limit.count == ra::unlimited ? ra::unlimited : limit.count + limit.offset };
+
+				using node = ra::top<typename decltype(clause)::node, kept, Node>;
+
+				if constexpr (limit.count == 0)
+				{
+					return context<limit.pos, ra::limit<0, 0, false, Node>>{};
+				}
+				else if constexpr (limit.offset == 0)
+				{
+					return context<limit.pos, node>{};
+				}
+				else
+				{
+					return context<limit.pos, ra::limit<limit.count, limit.offset, true, node>>{};
+				}
+			}
+			else
+			{
+				constexpr auto limit{ parse_limit<Pos>() };
+
+				if constexpr (limit.count == ra::unlimited)
+				{
+					return context<Pos, Node>{};
+				}
+				else
+				{
+					return context<limit.pos, ra::limit<limit.count, limit.offset, skippable<Node>::value, Node>>{};
+				}
+			}
+		}
+
 		// decide RA node to root the expression tree
 		template <std::size_t Pos>
 		static constexpr auto parse_root()
+		{
+			constexpr auto next{ parse_select<Pos>() };
+
+			return parse_order<next.pos, typename decltype(next)::node>();
+		}
+
+		// decide RA node to compute the rows of the select statement at Pos
+		template <std::size_t Pos>
+		static constexpr auto parse_select()
 		{
 			static_assert(isselect(tokens_[Pos]), "Expected 'SELECT' token not found.");
 
-			if constexpr (tokens_[Pos + 1] == "*")
+			if constexpr (grouped<Pos + 1>() || aggregated(Pos + 1))
+			{
+				return parse_group<Pos + 1>();
+			}
+			else if constexpr (tokens_[Pos + 1] == "*")
 			{
 				return parse_from<Pos + 2>();
 			}
@@ -661,39 +2401,145 @@ namespace sql
 
 		using expression = typename decltype(parse_root<0>())::node;
 
-		bool empty_;
-	
-	public:
-		using iterator = query_iterator<expression>;
-		using row_type = expression::output_type;
-
-		query(Schemas const&... tables)
+		// views are only valid while the rows they refer to stay in place
+		static constexpr bool viewable()
 		{
-			try 
+			if constexpr (scan<expression>::value)
 			{
-				expression::seed(tables...);
-				empty_ = false;
+				return !scan<expression>::schema::columnar;
 			}
-			catch(ra::data_end const& e)
+			else
 			{
-				empty_ = true;
+				return false;
 			}
 		}
 
-		~query()
+		static_assert(!View || viewable(), "View queries are limited to SELECT ... FROM ... WHERE over one row wise schema.");
+	
+	public:
+		using iterator = query_iterator<expression>;
+		using row_type = expression::output_type;
+
+		basic_query(Schemas const&... tables)
 		{
-			expression::reset();
+			expr_.seed(tables...);
 		}
 
+		// a seeded expression tree points into its own nodes, like the right rows a merge join grouped or a cross
+		//	join buffered, so a copy would point into the query it was copied from, queries are neither copied nor moved
+		basic_query(basic_query const&) = delete;
+
+		basic_query& operator=(basic_query const&) = delete;
+
 		inline iterator begin() const
 		{
-			return iterator{ empty_ };
+			return iterator{ &expr_ };
 		}
 
 		inline iterator end() const
 		{
-			return iterator{ true };
+			return iterator{ nullptr };
+		}
+
+		// streams the query output in batches of up to Size rows
+		template <std::size_t Size = 1024>
+		inline batch_range<expression, Size> batches() const
+		{
+			return batch_range<expression, Size>{ &expr_ };
+		}
+
+		// runs a single schema query over chunks of the table on the given number of threads
+		static std::vector<row_type> parallel(Schemas const&... tables, std::size_t threads = 0, merge order = merge::ordered)
+		{
+			static_assert(sizeof...(Schemas) == 1, "Parallel queries operate on a single schema.");
+			static_assert(scan<expression>::value, "Parallel queries are limited to SELECT ... FROM ... WHERE over one schema.");
+
+			using schema_type = std::remove_cvref_t<decltype((tables, ...))>;
+			using const_iterator = typename schema_type::const_iterator;
+			constexpr std::size_t batch_size{ 1024 };
+
+			auto const& table{ (tables, ...) };
+			std::size_t const size = std::distance(table.begin(), table.end());
+
+			if (threads == 0)
+			{
+				threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+			}
+
+			// several chunks per thread so faster threads pick up the slack
+			auto const step{ std::max<std::size_t>(size / (threads * 4), batch_size) };
+			std::vector<const_iterator> bounds{ table.begin() };
+
+			for (std::size_t pos{ step }; pos < size; pos += step)
+			{
+				bounds.push_back(std::next(bounds.back(), step));
+			}
+
+			bounds.push_back(table.end());
+
+			auto const chunks{ bounds.size() - 1 };
+			std::vector<std::vector<row_type>> outputs(order == merge::ordered ? chunks : threads);
+			std::atomic<std::size_t> claimed{};
+
+			auto work = [&](std::size_t id)
+			{
+				expression expr{};
+				std::vector<row_type const*> rows(batch_size);
+
+				for (auto chunk{ claimed++ }; chunk < chunks; chunk = claimed++)
+				{
+					auto& output{ outputs[order == merge::ordered ? chunk : id] };
+					expr.seed(ra::slice<schema_type>{ bounds[chunk], bounds[chunk + 1] });
+
+					for (auto count{ expr.next_batch(std::span{ rows }) }; count != 0; count = expr.next_batch(std::span{ rows }))
+					{
+						for (std::size_t i{}; i < count; ++i)
+						{
+							output.push_back(*rows[i]);
+						}
+					}
+				}
+			};
+
+			{
+				std::vector<std::jthread> workers{};
+
+				for (std::size_t id{ 1 }; id < threads; ++id)
+				{
+					workers.emplace_back(work, id);
+				}
+
+				work(0);
+			}
+
+			std::size_t total{};
+
+			for (auto const& output : outputs)
+			{
+				total += output.size();
+			}
+
+			std::vector<row_type> result{};
+			result.reserve(total);
+
+			for (auto& output : outputs)
+			{
+				std::move(output.begin(), output.end(), std::back_inserter(result));
+			}
+
+			return result;
 		}
+
+	private:
+		// the expression tree holds all cursor and row state for this object
+		mutable expression expr_{};
 	};
 
+	template <cexpr::string Str, typename... Schemas>
+	using query = basic_query<Str, false, Schemas...>;
+
+	// query whose std::string columns are output as std::string_view into the schema storage
+	template <cexpr::string Str, typename... Schemas>
+	using query_view = basic_query<Str, true, Schemas...>;
+
 } // namespace sql
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -12,6 +14,8 @@ namespace sql
 	struct void_row
 	{
 		static constexpr std::size_t depth{ 0 };
+
+		constexpr bool operator==(void_row const&) const noexcept = default;
 	};
 
 	template <typename Col, typename Next>
@@ -52,6 +56,9 @@ namespace sql
 		{
 			return value_;
 		}
+
+		// rows are equal when every column is, which lets rows key hash tables
+		bool operator==(row const&) const = default;
 	
 	private:
 		column::type value_;
@@ -78,6 +85,27 @@ namespace sql
 		using row_type = row<Col, decltype(resolve())>;
 	};
 
+	// compile time check for whether a column name is present in a row type
+	template <cexpr::string Name, typename Row>
+	constexpr bool exists() noexcept
+	{
+		if constexpr (std::is_same_v<Row, sql::void_row>)
+		{
+			return false;
+		}
+		else
+		{
+			if constexpr (Row::column::name == Name)
+			{
+				return true;
+			}
+			else
+			{
+				return exists<Name, typename Row::next>();
+			}
+		}
+	}
+
 	// user function to query row elements by column name
 	template <cexpr::string Name, typename Row>
 	constexpr auto const& get(Row const& r) noexcept
@@ -142,4 +170,23 @@ namespace std
 		using type = decltype(sql::get<Index>(sql::row<Col, Next>{}));
 	};
 
+	// combines the hashes of every column, used for rows keying hash tables like the keys of GROUP BY
+	template <typename Col, typename Next>
+	struct hash<sql::row<Col, Next>>
+	{
+		size_t operator()(sql::row<Col, Next> const& row) const
+		{
+			auto const seed{ hash<typename Col::type>{}(row.head()) };
+
+			if constexpr (is_same_v<Next, sql::void_row>)
+			{
+				return seed;
+			}
+			else
+			{
+				return seed ^ (hash<Next>{}(row.tail()) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+			}
+		}
+	};
+
 } // namespace std
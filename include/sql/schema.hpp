@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <fstream>
 #include <set>
 #include <type_traits>
@@ -9,29 +11,79 @@
 #include "cexpr/string.hpp"
 
 #include "sql/column.hpp"
+#include "sql/columnar.hpp"
 #include "sql/index.hpp"
 #include "sql/row.hpp"
 
 namespace sql
 {
 
+	// last generation handed to a schema, shared by every schema type so no two states of any schemas share one
+	inline std::atomic<std::size_t> generations{};
+
 	template <cexpr::string Name, typename Index, typename... Cols>
 	class schema
 	{
 	public:
 		static constexpr auto name{ Name };
+		static constexpr bool columnar{ std::is_same_v<Index, sql::columnar> };
 
 		using row_type = sql::variadic_row<Cols...>::row_type;
-		using container = typename
-			std::conditional_t<
-				std::is_same_v<Index, sql::index<>>,
-				std::vector<row_type>,
-				std::multiset<row_type, typename Index::template comparator<row_type>>
-			>;
+
+	private:
+		// sql::columnar stores a column_store, sql::index<> a vector, otherwise a sorted multiset
+		static inline constexpr auto resolve() noexcept
+		{
+			if constexpr (columnar)
+			{
+				return sql::column_store<row_type>{};
+			}
+			else if constexpr (std::is_same_v<Index, sql::index<>>)
+			{
+				return std::vector<row_type>{};
+			}
+			else
+			{
+				return std::multiset<row_type, typename Index::template comparator<row_type>>{};
+			}
+		}
+
+	public:
+		using container = decltype(resolve());
 		using const_iterator = typename container::const_iterator;
+
+		// true when begin and end walk the rows in ascending order of the Column column
+		template <cexpr::string Column>
+		static constexpr bool ordered() noexcept
+		{
+			if constexpr (columnar)
+			{
+				return false;
+			}
+			else
+			{
+				return Index::template leads<Column>();
+			}
+		}
 		
 		schema() = default;
 
+		schema(schema const&) = default;
+
+		schema& operator=(schema const&) = default;
+
+		// the moved from schema gets a generation of its own since its rows are gone
+		schema(schema&& other) : table_{ std::move(other.table_) }, generation_{ std::exchange(other.generation_, advance()) }
+		{}
+
+		schema& operator=(schema&& other)
+		{
+			table_ = std::move(other.table_);
+			generation_ = std::exchange(other.generation_, advance());
+
+			return *this;
+		}
+
 		template <typename Type, typename... Types>
 		schema(std::vector<Type> const& col, Types const&... cols) : schema{}
 		{
@@ -47,7 +99,7 @@ namespace sql
 		template <typename... Types>
 		inline void emplace(Types const&... vals)
 		{
-			if constexpr (std::is_same_v<Index, sql::index<>>)
+			if constexpr (std::is_same_v<Index, sql::index<>> || columnar)
 			{
 				table_.emplace_back(vals...);
 			}
@@ -55,12 +107,14 @@ namespace sql
 			{
 				table_.emplace(vals...);
 			}
+
+			generation_ = advance();
 		}
 
 		template <typename... Types>
 		inline void emplace(Types&&... vals)
 		{
-			if constexpr (std::is_same_v<Index, sql::index<>>)
+			if constexpr (std::is_same_v<Index, sql::index<>> || columnar)
 			{
 				table_.emplace_back(vals...);
 			}
@@ -68,6 +122,8 @@ namespace sql
 			{
 				table_.emplace(vals...);
 			}
+
+			generation_ = advance();
 		}
 
 		template <typename Type, typename... Types>
@@ -90,7 +146,7 @@ namespace sql
 
 		void insert(row_type const& row)
 		{
-			if constexpr (std::is_same_v<Index, sql::index<>>)
+			if constexpr (std::is_same_v<Index, sql::index<>> || columnar)
 			{
 				table_.push_back(row);
 			}
@@ -98,11 +154,13 @@ namespace sql
 			{
 				table_.insert(row);
 			}
+
+			generation_ = advance();
 		}
 
 		void insert(row_type&& row)
 		{
-			if constexpr (std::is_same_v<Index, sql::index<>>)
+			if constexpr (std::is_same_v<Index, sql::index<>> || columnar)
 			{
 				table_.push_back(std::forward<row_type>(row));
 			}
@@ -110,6 +168,8 @@ namespace sql
 			{
 				table_.insert(std::forward<row_type>(row));
 			}
+
+			generation_ = advance();
 		}
 
 		inline const_iterator begin() const noexcept
@@ -122,10 +182,40 @@ namespace sql
 			return table_.end();
 		}
 
+		// number of rows held, read from the container without walking the rows of a sorted schema
+		inline std::size_t size() const noexcept
+		{
+			return table_.size();
+		}
+
+		// rows whose leading index column equals key, only for schemas with a non empty sql::index
+		template <typename Key>
+		inline std::pair<const_iterator, const_iterator> equal_range(Key const& key) const
+		{
+			return table_.equal_range(key);
+		}
+
+		// changes whenever rows are added, copies of a schema share the generation of its rows
+		inline std::size_t generation() const noexcept
+		{
+			return generation_;
+		}
+
 	private:
+		// generations start at one so zero can mark rows which are not tracked
+		static inline std::size_t advance() noexcept
+		{
+			return generations.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
 		container table_;
+		std::size_t generation_{ advance() };
 	};
 
+	// expected row count of Schema, specializations let chains of joins join the smaller relations first
+	template <typename Schema>
+	inline constexpr std::size_t cardinality{};
+
 	namespace
 	{
 
@@ -159,7 +249,18 @@ namespace sql
 		{
 			if constexpr (!std::is_same_v<Row, sql::void_row>)
 			{
-				fstr << row.head();
+				// null values of nullable columns are written as empty fields
+				if constexpr (nullable_type<typename Row::column::type>::value)
+				{
+					if (row.head())
+					{
+						fstr << *row.head();
+					}
+				}
+				else
+				{
+					fstr << row.head();
+				}
 
 				if constexpr (std::is_same_v<typename Row::next, sql::void_row>)
 				{
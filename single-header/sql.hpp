@@ -1,15 +1,25 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
-#include <exception>
+#include <cstdint>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <locale>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -178,6 +188,28 @@ namespace sql
 		using type = Type;
 	};
 
+	namespace
+	{
+
+		// true for the types of nullable columns, type is the optional Type nullable columns hold
+		template <typename Type>
+		struct nullable_type : std::false_type
+		{
+			using type = std::optional<Type>;
+		};
+
+		template <typename Type>
+		struct nullable_type<std::optional<Type>> : std::true_type
+		{
+			using type = std::optional<Type>;
+		};
+
+	} // namespace
+
+	// column of the same name whose values may be null, used for the padded inputs of outer joins
+	template <typename Col>
+	using nullable = column<Col::name, typename nullable_type<typename Col::type>::type>;
+
 } // namespace sql
 
 namespace sql
@@ -186,6 +218,8 @@ namespace sql
 	struct void_row
 	{
 		static constexpr std::size_t depth{ 0 };
+
+		constexpr bool operator==(void_row const&) const noexcept = default;
 	};
 
 	template <typename Col, typename Next>
@@ -226,6 +260,9 @@ namespace sql
 		{
 			return value_;
 		}
+
+		// rows are equal when every column is, which lets rows key hash tables
+		bool operator==(row const&) const = default;
 	
 	private:
 		column::type value_;
@@ -252,6 +289,27 @@ namespace sql
 		using row_type = row<Col, decltype(resolve())>;
 	};
 
+	// compile time check for whether a column name is present in a row type
+	template <cexpr::string Name, typename Row>
+	constexpr bool exists() noexcept
+	{
+		if constexpr (std::is_same_v<Row, sql::void_row>)
+		{
+			return false;
+		}
+		else
+		{
+			if constexpr (Row::column::name == Name)
+			{
+				return true;
+			}
+			else
+			{
+				return exists<Name, typename Row::next>();
+			}
+		}
+	}
+
 	// user function to query row elements by column name
 	template <cexpr::string Name, typename Row>
 	constexpr auto const& get(Row const& r) noexcept
@@ -316,23 +374,250 @@ namespace std
 		using type = decltype(sql::get<Index>(sql::row<Col, Next>{}));
 	};
 
+	// combines the hashes of every column, used for rows keying hash tables like the keys of GROUP BY
+	template <typename Col, typename Next>
+	struct hash<sql::row<Col, Next>>
+	{
+		size_t operator()(sql::row<Col, Next> const& row) const
+		{
+			auto const seed{ hash<typename Col::type>{}(row.head()) };
+
+			if constexpr (is_same_v<Next, sql::void_row>)
+			{
+				return seed;
+			}
+			else
+			{
+				return seed ^ (hash<Next>{}(row.tail()) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+			}
+		}
+	};
+
 } // namespace std
 
+namespace sql
+{
+
+	// sql::schema index argument which stores the data column wise (unsorted)
+	struct columnar
+	{};
+
+	// template recursive list of contiguous arrays, one per column of Row
+	template <typename Row>
+	class column_store
+	{
+	public:
+		using column = Row::column;
+		using next = column_store<typename Row::next>;
+
+		class const_iterator
+		{
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = Row;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = Row;
+
+			const_iterator() = default;
+
+			const_iterator(column_store const* store, std::size_t index) : store_{ store }, index_{ index }
+			{}
+
+			inline bool operator==(const_iterator const& it) const noexcept
+			{
+				return index_ == it.index_;
+			}
+
+			inline bool operator!=(const_iterator const& it) const noexcept
+			{
+				return !(*this == it);
+			}
+
+			// rows are materialized from the columns on dereference
+			inline Row operator*() const
+			{
+				Row row{};
+				load<Row>(row);
+
+				return row;
+			}
+
+			inline const_iterator& operator++() noexcept
+			{
+				++index_;
+
+				return *this;
+			}
+
+			inline const_iterator operator++(int) noexcept
+			{
+				return const_iterator{ store_, index_++ };
+			}
+
+			inline const_iterator& operator+=(std::size_t n) noexcept
+			{
+				index_ += n;
+
+				return *this;
+			}
+
+			inline difference_type operator-(const_iterator const& it) const noexcept
+			{
+				return index_ - it.index_;
+			}
+
+			// copies only the columns named in Cols into the row
+			template <typename Cols, typename Dest>
+			inline void load(Dest& row) const
+			{
+				store_->template load<Cols>(index_, row);
+			}
+
+			// copies only the columns named in Cols into consecutive rows, one column at a time
+			template <typename Cols, typename Dest>
+			inline void load(std::span<Dest> rows) const
+			{
+				store_->template load<Cols>(index_, rows);
+			}
+
+		private:
+			column_store const* store_{};
+			std::size_t index_{};
+		};
+
+		template <typename Type, typename... Types>
+		inline void emplace_back(Type&& val, Types&&... vals)
+		{
+			data_.emplace_back(std::forward<Type>(val));
+			next_.emplace_back(std::forward<Types>(vals)...);
+		}
+
+		inline void push_back(Row const& row)
+		{
+			data_.push_back(row.head());
+			next_.push_back(row.tail());
+		}
+
+		inline void push_back(Row&& row)
+		{
+			data_.push_back(std::move(row.head()));
+			next_.push_back(std::move(row.tail()));
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return data_.size();
+		}
+
+		inline const_iterator begin() const noexcept
+		{
+			return const_iterator{ this, 0 };
+		}
+
+		inline const_iterator end() const noexcept
+		{
+			return const_iterator{ this, data_.size() };
+		}
+
+		template <typename Cols, typename Dest>
+		void load(std::size_t index, Dest& row) const
+		{
+			if constexpr (sql::exists<column::name, Cols>())
+			{
+				sql::set<column::name>(row, data_[index]);
+			}
+
+			next_.template load<Cols>(index, row);
+		}
+
+		template <typename Cols, typename Dest>
+		void load(std::size_t first, std::span<Dest> rows) const
+		{
+			if constexpr (sql::exists<column::name, Cols>())
+			{
+				for (std::size_t i{}; i < rows.size(); ++i)
+				{
+					sql::set<column::name>(rows[i], data_[first + i]);
+				}
+			}
+
+			next_.template load<Cols>(first, rows);
+		}
+
+	private:
+		std::vector<typename column::type> data_;
+		next next_;
+	};
+
+	template <>
+	class column_store<sql::void_row>
+	{
+	public:
+		inline void emplace_back() noexcept
+		{}
+
+		inline void push_back([[maybe_unused]] sql::void_row const& row) noexcept
+		{}
+
+		template <typename Cols, typename Dest>
+		inline void load([[maybe_unused]] std::size_t index, [[maybe_unused]] Dest& row) const noexcept
+		{}
+	};
+
+} // namespace sql
+
 namespace sql
 {
 
 	template <cexpr::string... Columns>
 	struct index
 	{
+		// true when rows are sorted on the Name column before any other
+		template <cexpr::string Name>
+		static constexpr bool leads() noexcept
+		{
+			if constexpr (sizeof...(Columns) == 0)
+			{
+				return false;
+			}
+			else
+			{
+				return first<Name, Columns...>();
+			}
+		}
+
 		template <typename Row>
 		struct comparator
 		{
+			// allows multiset lookups by a value of the leading column
+			using is_transparent = void;
+
 			bool operator()(Row const& left, Row const& right) const noexcept
 			{
 				return compare<Columns...>(left, right);
 			}
+
+			template <typename Key>
+			bool operator()(Row const& left, Key const& right) const noexcept
+			{
+				return leading<Columns...>(left) < right;
+			}
+
+			template <typename Key>
+			bool operator()(Key const& left, Row const& right) const noexcept
+			{
+				return left < leading<Columns...>(right);
+			}
 		
 		private:
+			template <cexpr::string Col, cexpr::string... Cols>
+			static inline auto const& leading(Row const& row) noexcept
+			{
+				return sql::get<Col>(row);
+			}
+
+
 			template <cexpr::string Col, cexpr::string... Cols>
 			bool compare(Row const& left, Row const& right) const noexcept
 			{
@@ -350,6 +635,13 @@ namespace sql
 				return l < r;
 			}
 		};
+
+	private:
+		template <cexpr::string Name, cexpr::string Col, cexpr::string... Cols>
+		static constexpr bool first() noexcept
+		{
+			return Col == Name;
+		}
 	};
 
 } // namespace sql
@@ -357,23 +649,72 @@ namespace sql
 namespace sql
 {
 
+	// last generation handed to a schema, shared by every schema type so no two states of any schemas share one
+	inline std::atomic<std::size_t> generations{};
+
 	template <cexpr::string Name, typename Index, typename... Cols>
 	class schema
 	{
 	public:
 		static constexpr auto name{ Name };
+		static constexpr bool columnar{ std::is_same_v<Index, sql::columnar> };
 
 		using row_type = sql::variadic_row<Cols...>::row_type;
-		using container = typename
-			std::conditional_t<
-				std::is_same_v<Index, sql::index<>>,
-				std::vector<row_type>,
-				std::multiset<row_type, typename Index::template comparator<row_type>>
-			>;
+
+	private:
+		// sql::columnar stores a column_store, sql::index<> a vector, otherwise a sorted multiset
+		static inline constexpr auto resolve() noexcept
+		{
+			if constexpr (columnar)
+			{
+				return sql::column_store<row_type>{};
+			}
+			else if constexpr (std::is_same_v<Index, sql::index<>>)
+			{
+				return std::vector<row_type>{};
+			}
+			else
+			{
+				return std::multiset<row_type, typename Index::template comparator<row_type>>{};
+			}
+		}
+
+	public:
+		using container = decltype(resolve());
 		using const_iterator = typename container::const_iterator;
+
+		// true when begin and end walk the rows in ascending order of the Column column
+		template <cexpr::string Column>
+		static constexpr bool ordered() noexcept
+		{
+			if constexpr (columnar)
+			{
+				return false;
+			}
+			else
+			{
+				return Index::template leads<Column>();
+			}
+		}
 		
 		schema() = default;
 
+		schema(schema const&) = default;
+
+		schema& operator=(schema const&) = default;
+
+		// the moved from schema gets a generation of its own since its rows are gone
+		schema(schema&& other) : table_{ std::move(other.table_) }, generation_{ std::exchange(other.generation_, advance()) }
+		{}
+
+		schema& operator=(schema&& other)
+		{
+			table_ = std::move(other.table_);
+			generation_ = std::exchange(other.generation_, advance());
+
+			return *this;
+		}
+
 		template <typename Type, typename... Types>
 		schema(std::vector<Type> const& col, Types const&... cols) : schema{}
 		{
@@ -389,7 +730,7 @@ namespace sql
 		template <typename... Types>
 		inline void emplace(Types const&... vals)
 		{
-			if constexpr (std::is_same_v<Index, sql::index<>>)
+			if constexpr (std::is_same_v<Index, sql::index<>> || columnar)
 			{
 				table_.emplace_back(vals...);
 			}
@@ -397,12 +738,14 @@ namespace sql
 			{
 				table_.emplace(vals...);
 			}
+
+			generation_ = advance();
 		}
 
 		template <typename... Types>
 		inline void emplace(Types&&... vals)
 		{
-			if constexpr (std::is_same_v<Index, sql::index<>>)
+			if constexpr (std::is_same_v<Index, sql::index<>> || columnar)
 			{
 				table_.emplace_back(vals...);
 			}
@@ -410,6 +753,8 @@ namespace sql
 			{
 				table_.emplace(vals...);
 			}
+
+			generation_ = advance();
 		}
 
 		template <typename Type, typename... Types>
@@ -432,7 +777,7 @@ namespace sql
 
 		void insert(row_type const& row)
 		{
-			if constexpr (std::is_same_v<Index, sql::index<>>)
+			if constexpr (std::is_same_v<Index, sql::index<>> || columnar)
 			{
 				table_.push_back(row);
 			}
@@ -440,11 +785,13 @@ namespace sql
 			{
 				table_.insert(row);
 			}
+
+			generation_ = advance();
 		}
 
 		void insert(row_type&& row)
 		{
-			if constexpr (std::is_same_v<Index, sql::index<>>)
+			if constexpr (std::is_same_v<Index, sql::index<>> || columnar)
 			{
 				table_.push_back(std::forward<row_type>(row));
 			}
@@ -452,6 +799,8 @@ namespace sql
 			{
 				table_.insert(std::forward<row_type>(row));
 			}
+
+			generation_ = advance();
 		}
 
 		inline const_iterator begin() const noexcept
@@ -464,10 +813,40 @@ namespace sql
 			return table_.end();
 		}
 
+		// number of rows held, read from the container without walking the rows of a sorted schema
+		inline std::size_t size() const noexcept
+		{
+			return table_.size();
+		}
+
+		// rows whose leading index column equals key, only for schemas with a non empty sql::index
+		template <typename Key>
+		inline std::pair<const_iterator, const_iterator> equal_range(Key const& key) const
+		{
+			return table_.equal_range(key);
+		}
+
+		// changes whenever rows are added, copies of a schema share the generation of its rows
+		inline std::size_t generation() const noexcept
+		{
+			return generation_;
+		}
+
 	private:
+		// generations start at one so zero can mark rows which are not tracked
+		static inline std::size_t advance() noexcept
+		{
+			return generations.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
 		container table_;
+		std::size_t generation_{ advance() };
 	};
 
+	// expected row count of Schema, specializations let chains of joins join the smaller relations first
+	template <typename Schema>
+	inline constexpr std::size_t cardinality{};
+
 	namespace
 	{
 
@@ -501,7 +880,18 @@ namespace sql
 		{
 			if constexpr (!std::is_same_v<Row, sql::void_row>)
 			{
-				fstr << row.head();
+				// null values of nullable columns are written as empty fields
+				if constexpr (nullable_type<typename Row::column::type>::value)
+				{
+					if (row.head())
+					{
+						fstr << *row.head();
+					}
+				}
+				else
+				{
+					fstr << row.head();
+				}
 
 				if constexpr (std::is_same_v<typename Row::next, sql::void_row>)
 				{
@@ -576,39 +966,63 @@ namespace ra
 	class unary
 	{
 	public:
-		using input_type = std::remove_cvref_t<decltype(Input::next())>;
+		using input_type = std::remove_cvref_t<typename Input::output_type>;
 
 		template <typename... Inputs>
-		static inline void seed(Inputs const&... rs)
+		inline void seed(Inputs const&... rs)
+		{
+			input_.seed(rs...);
+		}
+
+		inline void reset()
+		{
+			input_.reset();
+		}
+
+		// rows of the seeded input, an upper bound for nodes which filter their input
+		inline std::size_t size() const
 		{
-			Input::seed(rs...);
+			return input_.size();
 		}
 
-		static inline void reset()
+		inline std::size_t generation() const
 		{
-			Input::reset();
+			return input_.generation();
 		}
+
+	protected:
+		Input input_;
 	};
 
 	template <typename LeftInput, typename RightInput>
 	class binary
 	{
 	public:
-		using left_type = std::remove_cvref_t<decltype(LeftInput::next())>;
-		using right_type = std::remove_cvref_t<decltype(RightInput::next())>;
+		using left_type = std::remove_cvref_t<typename LeftInput::output_type>;
+		using right_type = std::remove_cvref_t<typename RightInput::output_type>;
 
 		template <typename... Inputs>
-		static inline void seed(Inputs const&... rs)
+		inline void seed(Inputs const&... rs)
+		{
+			left_.seed(rs...);
+			right_.seed(rs...);
+		}
+
+		inline void reset()
 		{
-			LeftInput::seed(rs...);
-			RightInput::seed(rs...);
+			left_.reset();
+			right_.reset();
 		}
 
-		static inline void reset()
+		// joined rows are not tracked, so tables built over them are rebuilt on every seed
+		inline std::size_t generation() const noexcept
 		{
-			LeftInput::reset();
-			RightInput::reset();
+			return 0;
 		}
+
+	protected:
+		LeftInput left_;
+		RightInput right_;
 	};
 
 } // namespace ra
@@ -634,10 +1048,24 @@ namespace ra
 			}
 		}
 
+		// true when merge drops the leading column of Right in favour of the one of Left
+		template <typename Left, typename Right>
+		constexpr bool shared() noexcept
+		{
+			if constexpr (std::is_same_v<Left, sql::void_row> || std::is_same_v<Right, sql::void_row>)
+			{
+				return false;
+			}
+			else
+			{
+				return Left::column::name == Right::column::name;
+			}
+		}
+
 		template <typename Left, typename Right>
 		inline constexpr auto merge()
 		{
-			if constexpr (Left::column::name == Right::column::name)
+			if constexpr (shared<Left, Right>())
 			{
 				return recr_merge<Left, typename Right::next>();
 			}
@@ -647,1010 +1075,5056 @@ namespace ra
 			}
 		}
 
-		template <typename Dest, typename Row>
-		constexpr void recr_copy(Dest& dest, Row const& src)
+		// Row with every column nullable, the columns of the input an outer join pads with nulls
+		template <typename Row>
+		constexpr auto padded()
 		{
 			if constexpr (std::is_same_v<Row, sql::void_row>)
 			{
-				return;
+				return sql::void_row{};
 			}
 			else
 			{
-				dest.head() = src.head();
-				recr_copy(dest.tail(), src.tail());
+				using next = decltype(padded<typename Row::next>());
+
+				return sql::row<sql::nullable<typename Row::column>, next>{};
 			}
 		}
 
-		template <typename Dest, typename Row>
-		inline constexpr void copy(Dest& dest, Row const& src)
+		// columns of Right which merge places after the columns of Left
+		template <typename Left, typename Right>
+		constexpr auto remainder()
 		{
-			if constexpr (Dest::column::name == Row::column::name)
+			if constexpr (shared<Left, Right>())
 			{
-				recr_copy(dest, src);
+				return typename Right::next{};
 			}
 			else
 			{
-				copy(dest.tail(), src);
+				return Right{};
 			}
 		}
 
-	} // namespace
-
-	template <typename LeftInput, typename RightInput>
+		template <typename Dest, typename Row>
+		constexpr void recr_copy(Dest& dest, Row const& src)
+		{
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return;
+			}
+			else
+			{
+				dest.head() = src.head();
+				recr_copy(dest.tail(), src.tail());
+			}
+		}
+
+		// copies src into dest starting one past the columns of Left
+		template <typename Left, typename Dest, typename Row>
+		constexpr void copy_after(Dest& dest, Row const& src)
+		{
+			if constexpr (std::is_same_v<Left, sql::void_row>)
+			{
+				recr_copy(dest, src);
+			}
+			else
+			{
+				copy_after<typename Left::next>(dest.tail(), src);
+			}
+		}
+
+		// skips the columns of Skip in dest, then copies the columns of Cols from src by name
+		template <typename Skip, typename Cols, typename Dest, typename Row>
+		constexpr void fold(Dest& dest, Row const& src)
+		{
+			if constexpr (!std::is_same_v<Skip, sql::void_row>)
+			{
+				fold<typename Skip::next, Cols>(dest.tail(), src);
+			}
+			else if constexpr (std::is_same_v<Cols, sql::void_row>)
+			{
+				return;
+			}
+			else
+			{
+				dest.head() = sql::get<Cols::column::name>(src);
+				fold<sql::void_row, typename Cols::next>(dest.tail(), src);
+			}
+		}
+
+	} // namespace
+
+	// input of a hash join which its table is built over, smaller picks the input with fewer rows once seeded
+	enum class side
+	{
+		left,
+		right,
+		smaller
+	};
+
+	// inputs whose unmatched rows an outer join keeps
+	enum class keep
+	{
+		left,
+		right,
+		both
+	};
+
+	// Left and Right list the columns of each input carried into the output rows
+	template <typename LeftInput, typename RightInput, typename Left, typename Right>
 	class join : public ra::binary<LeftInput, RightInput>
 	{
 		using binary_type = ra::binary<LeftInput, RightInput>;
-		using left_type = typename binary_type::left_type;
-		using right_type = typename binary_type::right_type;
+	protected:
+		using left_input_type = typename binary_type::left_type;
+		using right_input_type = typename binary_type::right_type;
+		using left_type = Left;
+		using right_type = Right;
 	public:
 		using output_type = decltype(merge<left_type, right_type>());
 
 		template <typename... Inputs>
-		static inline void seed(Inputs const&... rs)
+		inline void seed(Inputs const&... rs)
 		{
 			binary_type::seed(rs...);
-			copy(output_row, LeftInput::next());
+			advance();
 		}
 
-		static inline void reset()
+		inline void reset()
 		{
 			binary_type::reset();
-			copy(output_row, LeftInput::next());
+			advance();
 		}
 
-		static output_type output_row;
-	};
+	protected:
+		// copies the next left row into the output row, false once the left input is exhausted
+		inline bool advance()
+		{
+			auto const* row{ this->left_.next() };
 
-	template <typename LeftInput, typename RightInput>
-	typename join<LeftInput, RightInput>::output_type join<LeftInput, RightInput>::output_row{};
+			if (row != nullptr)
+			{
+				fold<sql::void_row, left_type>(output_row_, *row);
+			}
+
+			active_ = row != nullptr;
+
+			return active_;
+		}
+
+		// right rows are placed after the left columns, less their leading column when merge dropped it
+		static inline void copy_right(output_type& dest, right_input_type const& src)
+		{
+			fold<left_type, decltype(remainder<left_type, right_type>())>(dest, src);
+		}
+
+		output_type output_row_{};
+		bool active_{};
+	};
 
 } // namespace ra
 
 namespace ra
 {
 
-	struct data_end : std::exception
-	{};
+	// contiguous sub range of a schema's rows, seeds a relation with part of a table
+	template <typename Schema>
+	struct slice
+	{
+		Schema::const_iterator first;
+		Schema::const_iterator last;
+
+		inline Schema::const_iterator begin() const noexcept
+		{
+			return first;
+		}
+
+		inline Schema::const_iterator end() const noexcept
+		{
+			return last;
+		}
+	};
 
 	// Id template parameter allows unique ra::relation types to be instantiated from
 	//	a single sql::schema type (for queries referencing a schema multiple times).
-	template <typename Schema, std::size_t Id>
+	// Columns lists the columns a query reads, only those are loaded from column wise schemas.
+	template <typename Schema, std::size_t Id, typename Columns = Schema::row_type>
 	class relation
 	{
 	public:
-		using output_type = Schema::row_type&;
+		using output_type = Schema::row_type;
 
-		static auto& next()
+		// nullptr signals the end of the data stream
+		inline output_type const* next() noexcept(!Schema::columnar)
 		{
-			if (curr != end)
+			if (curr_ != end_)
 			{
-				return *curr++;
+				if constexpr (Schema::columnar)
+				{
+					curr_++.template load<Columns>(output_row_);
+
+					return &output_row_;
+				}
+				else
+				{
+					return &*curr_++;
+				}
 			}
 			else
 			{
-				throw ra::data_end{};
+				return nullptr;
 			}
 		}
-		
-		template <typename Input, typename... Inputs>
-		static void seed(Input const& r, Inputs const&... rs) noexcept
+
+		// fills rows with pointers to up to rows.size() rows, zero signals the end of the data stream
+		inline std::size_t next_batch(std::span<output_type const*> rows) noexcept(!Schema::columnar)
 		{
-			if constexpr (std::is_same_v<Input, Schema>)
+			std::size_t size{};
+
+			if constexpr (Schema::columnar)
 			{
-				curr = r.begin();
-				begin = r.begin();
-				end = r.end();
+				if (buffer_.size() < rows.size())
+				{
+					buffer_.resize(rows.size());
+				}
+
+				size = std::min<std::size_t>(rows.size(), end_ - curr_);
+				curr_.template load<Columns>(std::span{ buffer_.data(), size });
+				curr_ += size;
+
+				for (std::size_t i{}; i < size; ++i)
+				{
+					rows[i] = &buffer_[i];
+				}
 			}
 			else
 			{
-				seed(rs...);
+				for (; size < rows.size() && curr_ != end_; ++size, ++curr_)
+				{
+					rows[size] = &*curr_;
+				}
 			}
+
+			return size;
 		}
 
-		static inline void reset() noexcept
+		// advances past up to count rows without reading them, returns the number of rows skipped
+		inline std::size_t skip(std::size_t count) noexcept
 		{
-			curr = begin;
-		}
+			std::size_t size{};
 
-	private:
-		static Schema::const_iterator curr;
-		static Schema::const_iterator begin;
-		static Schema::const_iterator end;
-	};
+			if constexpr (Schema::columnar || std::random_access_iterator<typename Schema::const_iterator>)
+			{
+				size = std::min<std::size_t>(count, end_ - curr_);
+				curr_ += size;
+			}
+			else
+			{
+				for (; size < count && curr_ != end_; ++curr_)
+				{
+					++size;
+				}
+			}
 
-	template <typename Schema, std::size_t Id>
-	Schema::const_iterator relation<Schema, Id>::curr{};
+			return size;
+		}
 
-	template <typename Schema, std::size_t Id>
-	Schema::const_iterator relation<Schema, Id>::begin{};
+		// late materialization for column wise schemas under a selection, the columns read by
+		//	Predicate are loaded for every row and the remaining columns only for qualifying rows
+		template <typename Predicate>
+		output_type const* next_where()
+		{
+			using keys = decltype(split<Predicate, true, Columns>());
+			using rest = decltype(split<Predicate, false, Columns>());
 
-	template <typename Schema, std::size_t Id>
-	Schema::const_iterator relation<Schema, Id>::end{};
+			for (; curr_ != end_; ++curr_)
+			{
+				curr_.template load<keys>(output_row_);
 
-} // namespace ra
+				if (Predicate::eval(output_row_))
+				{
+					curr_++.template load<rest>(output_row_);
 
-namespace ra
-{
+					return &output_row_;
+				}
+			}
 
-	template <typename LeftInput, typename RightInput>
-	class cross : public ra::join<LeftInput, RightInput>
-	{
-		using join_type = ra::join<LeftInput, RightInput>;
-	public:
-		using output_type = join_type::output_type;
+			return nullptr;
+		}
 
-		static auto&& next()
+		// batch of late materialized rows, a batch is only refilled once none of its rows qualified
+		template <typename Predicate>
+		std::size_t next_batch_where(std::span<output_type const*> rows)
 		{
-			try
-			{
-				copy(join_type::output_row, RightInput::next());
-			}
-			catch(ra::data_end const& e)
+			using keys = decltype(split<Predicate, true, Columns>());
+			using rest = decltype(split<Predicate, false, Columns>());
+
+			if (buffer_.size() < rows.size())
 			{
-				copy(join_type::output_row, LeftInput::next());
-				RightInput::reset();
-				copy(join_type::output_row, RightInput::next());
+				buffer_.resize(rows.size());
 			}
 
-			return std::move(join_type::output_row);
-		}
-	};
+			std::size_t size{};
 
-} // namespace ra
+			while (size == 0 && curr_ != end_)
+			{
+				auto const count{ std::min<std::size_t>(rows.size(), end_ - curr_) };
+				curr_.template load<keys>(std::span{ buffer_.data(), count });
 
-namespace ra
-{
+				for (std::size_t i{}; i < count; ++i)
+				{
+					if (Predicate::eval(buffer_[i]))
+					{
+						auto row{ curr_ };
+						row += i;
+						row.template load<rest>(buffer_[i]);
+						rows[size++] = &buffer_[i];
+					}
+				}
 
-	template <typename LeftInput, typename RightInput>
-	class natural : public ra::join<LeftInput, RightInput>
-	{
-		using join_type = ra::join<LeftInput, RightInput>;
-		using key_type = std::remove_cvref_t<decltype(LeftInput::next().head())>;
-		using value_type = std::vector<std::remove_cvref_t<decltype(RightInput::next().tail())>>;
-		using map_type = std::unordered_map<key_type, value_type>;
-	public:
-		using output_type = join_type::output_type;
+				curr_ += count;
+			}
 
-		template <typename... Inputs>
-		static void seed(Inputs const&... rs)
+			return size;
+		}
+		
+		template <typename Input, typename... Inputs>
+		void seed(Input const& r, Inputs const&... rs) noexcept
 		{
-			join_type::seed(rs...);
-			
-			if (row_cache.empty())
+			if constexpr (std::is_same_v<Input, Schema> || std::is_same_v<Input, ra::slice<Schema>>)
 			{
-				try
+				curr_ = r.begin();
+				begin_ = r.begin();
+				end_ = r.end();
+				last_ = r.end();
+
+				if constexpr (std::is_same_v<Input, Schema>)
 				{
-					for (;;)
-					{
-						auto const& row{ RightInput::next() };
-						row_cache[row.head()].push_back(row.tail());
-					}
+					table_ = &r;
 				}
-				catch(ra::data_end const& e)
+				else
 				{
-					RightInput::reset();
+					table_ = nullptr;
 				}
 			}
+			else
+			{
+				seed(rs...);
+			}
+		}
 
-			auto const& active{ row_cache[join_type::output_row.head()] };
-			curr = active.cbegin();
-			end = active.cend();
+		inline void reset() noexcept
+		{
+			curr_ = begin_;
+			end_ = last_;
 		}
 
-		static auto&& next()
+		// number of rows the relation was seeded with, only slices of a sorted schema are counted by walking their rows
+		inline std::size_t size() const noexcept
 		{
-			while (curr == end)
+			if (table_ != nullptr)
 			{
-				copy(join_type::output_row, LeftInput::next());
-				auto const& active{ row_cache[join_type::output_row.head()] };
-				curr = active.cbegin();
-				end = active.cend();
+				return table_->size();
 			}
 
-			copy(join_type::output_row, *curr++);
-			
-			return std::move(join_type::output_row);
+			if constexpr (Schema::columnar || std::random_access_iterator<typename Schema::const_iterator>)
+			{
+				return last_ - begin_;
+			}
+			else
+			{
+				return std::distance(begin_, last_);
+			}
 		}
 
-	private:
-		static map_type row_cache;
-		static value_type::const_iterator curr;
-		static value_type::const_iterator end;
-	};
-
-	template <typename LeftInput, typename RightInput>
-	typename natural<LeftInput, RightInput>::map_type natural<LeftInput, RightInput>::row_cache{};
-
-	template <typename LeftInput, typename RightInput>
-	typename natural<LeftInput, RightInput>::value_type::const_iterator natural<LeftInput, RightInput>::curr;
-
-	template <typename LeftInput, typename RightInput>
-	typename natural<LeftInput, RightInput>::value_type::const_iterator natural<LeftInput, RightInput>::end;
-
-} // namespace ra
-
-namespace ra
-{
-
-	template <typename Output, typename Input>
-	class projection : public ra::unary<Input>
-	{
-		using input_type =  typename ra::unary<Input>::input_type;
-	public:
-		using output_type = Output;
+		// generation of the seeded schema, zero for slices whose rows are not tracked
+		inline std::size_t generation() const noexcept
+		{
+			return table_ != nullptr ? table_->generation() : 0;
+		}
 
-		static auto&& next()
+		// narrows the stream to the rows whose Column equals key, the schema must be indexed on Column
+		template <cexpr::string Column, typename Key>
+		inline void seek(Key const& key)
 		{
-			fold<output_type>(output_row, Input::next());
-			
-			return std::move(output_row);
+			static_assert(Schema::template ordered<Column>(), "Relation seek requires a schema indexed on the column.");
+
+			auto const [first, last]{ table_->equal_range(key) };
+			curr_ = first;
+			end_ = last;
 		}
 
 	private:
-		template <typename Dest>
-		static inline constexpr void fold(Dest& dest, input_type const& src)
+		// columns of Row which Predicate reads when Read is true, or does not read otherwise
+		template <typename Predicate, bool Read, typename Row>
+		static constexpr auto split()
 		{
-			if constexpr (Dest::depth == 0)
+			if constexpr (std::is_same_v<Row, sql::void_row>)
 			{
-				return;
+				return sql::void_row{};
 			}
 			else
 			{
-				dest.head() = sql::get<Dest::column::name>(src);
-				fold<typename Dest::next>(dest.tail(), src);	
+				using next = decltype(split<Predicate, Read, typename Row::next>());
+
+				if constexpr (Predicate::template reads<Row::column::name>() == Read)
+				{
+					return sql::row<typename Row::column, next>{};
+				}
+				else
+				{
+					return next{};
+				}
 			}
 		}
 
-		static output_type output_row;
-	};
+		Schema::const_iterator curr_{};
+		Schema::const_iterator begin_{};
+		Schema::const_iterator end_{};
+		Schema::const_iterator last_{};
+		Schema const* table_{};
 
-	template <typename Output, typename Input>
-	typename projection<Output, Input>::output_type projection<Output, Input>::output_row{};
+		// column wise schemas are read into these rows, other schemas are pointed into directly
+		std::conditional_t<Schema::columnar, output_type, sql::void_row> output_row_{};
+		std::conditional_t<Schema::columnar, std::vector<output_type>, sql::void_row> buffer_{};
+	};
 
 } // namespace ra
 
 namespace ra
 {
 
-	template <typename Output, typename Input>
-	class rename : public ra::unary<Input>
+	namespace
+	{
+
+		// column wise relations filter rows themselves so unread columns are never loaded
+		template <typename Input>
+		struct late : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct late<ra::relation<Schema, Id, Columns>> : std::bool_constant<Schema::columnar>
+		{};
+
+	} // namespace
+
+	template <typename Predicate, typename Input>
+	class selection : public ra::unary<Input>
 	{
 		using input_type = typename ra::unary<Input>::input_type;
 	public:
-		using output_type = Output;
+		using output_type = input_type;		
 
-		static auto&& next()
+		output_type const* next()
 		{
-			fold<output_type, input_type>(output_row, Input::next());
-			
-			return std::move(output_row);
+			if constexpr (late<Input>::value)
+			{
+				return this->input_.template next_where<Predicate>();
+			}
+			else
+			{
+				for (auto const* row{ this->input_.next() }; row != nullptr; row = this->input_.next())
+				{
+					if (Predicate::eval(*row))
+					{
+						return row;
+					}
+				}
+
+				return nullptr;
+			}
 		}
 
-	private:
-		template <typename Dest, typename Src>
-		static inline constexpr void fold(Dest& dest, Src const& src)
+		// filters an input batch in place, a batch is only refilled once none of its rows qualified
+		std::size_t next_batch(std::span<output_type const*> rows)
 		{
-			if constexpr (Dest::depth == 0)
+			if constexpr (late<Input>::value)
 			{
-				return;
+				return this->input_.template next_batch_where<Predicate>(rows);
 			}
 			else
 			{
-				dest.head() = src.head();
-				fold<typename Dest::next, typename Src::next>(dest.tail(), src.tail());
+				std::size_t size{};
+
+				while (size == 0)
+				{
+					auto const count{ this->input_.next_batch(rows) };
+
+					if (count == 0)
+					{
+						break;
+					}
+
+					for (std::size_t i{}; i < count; ++i)
+					{
+						if (Predicate::eval(*rows[i]))
+						{
+							rows[size++] = rows[i];
+						}
+					}
+				}
+
+				return size;
 			}
 		}
 
-		static output_type output_row;
+		// narrows the input to the rows whose Column equals key
+		template <cexpr::string Column, typename Key>
+		inline void seek(Key const& key)
+		{
+			this->input_.template seek<Column>(key);
+		}
 	};
 
-	template <typename Output, typename Input>
-	typename rename<Output, Input>::output_type rename<Output, Input>::output_row{};
-	
 } // namespace ra
 
 namespace ra
 {
 
-	template <typename Predicate, typename Input>
-	class selection : public ra::unary<Input>
+	namespace
 	{
-		using input_type = typename ra::unary<Input>::input_type;
+
+		// scans of row wise schemas hand out pointers to rows already in memory, other inputs are
+		//	filtered, projected, or loaded again on every rescan
+		template <typename Input>
+		struct resident : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct resident<ra::relation<Schema, Id, Columns>> : std::bool_constant<!Schema::columnar>
+		{};
+
+		// inputs whose row pointers stay valid until they are seeded again, selections forward their input's rows
+		template <typename Input>
+		struct stable : resident<Input>
+		{};
+
+		template <typename Predicate, typename Input>
+		struct stable<ra::selection<Predicate, Input>> : stable<Input>
+		{};
+
+	} // namespace
+
+	// block nested loop cross product, each block of Block left rows is paired with every block of Block right
+	//	rows so the right input is rescanned once per left block instead of once per left row, right inputs
+	//	which are not resident are drained once per seed and their rows are rescanned instead
+	template <typename LeftInput, typename RightInput,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>,
+		std::size_t Block = 64>
+	class cross : public ra::join<LeftInput, RightInput, Left, Right>
+	{
+		using join_type = ra::join<LeftInput, RightInput, Left, Right>;
+		using left_type = typename join_type::left_type;
+		using right_input_type = typename join_type::right_input_type;
+
+		static constexpr bool materialize{ !resident<RightInput>::value };
+		static constexpr bool copy{ materialize && !stable<RightInput>::value };
+
+		static_assert(Block > 0, "Cross join blocks hold at least one row.");
 	public:
-		using output_type = input_type;		
+		using output_type = join_type::output_type;
 
-		static auto&& next()
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
 		{
-			output_row = Input::next();
+			join_type::seed(rs...);
 
-			while(!Predicate::eval(output_row))
+			if constexpr (materialize)
 			{
-				output_row = Input::next();
+				drain();
 			}
 
-			return std::move(output_row);
+			restart();
 		}
 
-	private:
-		static output_type output_row;
-	};
-
-	template <typename Output, typename Input>
-	typename selection<Output, Input>::output_type selection<Output, Input>::output_row{};
-
-} // namespace ra
-
-namespace sql
-{
-	namespace
-	{
-		
-		template <typename Char>
-		constexpr bool whitespace(Char curr)
-		{
-			return curr == Char{ ' ' } || curr == Char{ '\t' } || curr == Char{ '\n' };
-		}
-
-		template <typename Char>
-		constexpr bool syntax(Char curr)
-		{
-			return curr == Char{ ',' } || curr == Char{ '(' } || curr == Char{ ')' } ||
-				curr == Char{ '\'' } || curr == Char{ '\"' } || curr == Char{ '=' };
-		}
-
-		template <typename Char>
-		constexpr const Char* skip(const Char *curr, const Char *end)
+		void reset()
 		{
-			for (; curr != end && whitespace(*curr); ++curr);
-			return curr;
+			join_type::reset();
+			restart();
 		}
 
-		template <typename Char>
-		constexpr const Char* next(const Char *curr, const Char *end)
+		output_type const* next()
 		{
-			Char c{ *curr };
-
-			if (c == Char{ '>' } || c == Char{ '<' } || c == Char{ '!' })
+			if (j_ == right_size_ && !forward())
 			{
-				++curr;
-
-				if (*curr == Char{ '=' } || (c == Char{ '<' } && *curr == Char{ '>' }))
-				{
-					++curr;
-				}
-			}
-			else if (syntax(c))
-			{
-				++curr;
+				return nullptr;
 			}
-			else
+
+			// the left columns only change once every right row of the block was paired with them
+			if (j_ == 0)
 			{
-				for (; curr != end && !whitespace(*curr) && !syntax(*curr); ++curr);
+				recr_copy(row_, block_[i_]);
 			}
-			
-			return curr;
-		}
-	
-	} // namespace
 
-	template <typename Char, std::size_t Count>
-	class tokens
-	{
-	public:
-		using token_view = std::basic_string_view<Char>;
+			join_type::copy_right(row_, *batch_[j_++]);
 
-		constexpr tokens() = default;
+			return &row_;
+		}
 
-		template<std::size_t N>
-		constexpr tokens(cexpr::string<Char, N> const& cs) : tokens_{}
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
 		{
-			auto curr{ cs.cbegin() }, last{ cs.cbegin() };
-			const auto end{ cs.cend() };
-			std::size_t i{};
+			std::size_t size{};
 
-			while (curr < end)
+			if (buffer_.size() < rows.size())
 			{
-				curr = skip(curr, end);
-				last = curr;
-				last = next(last, end);
+				buffer_.resize(rows.size());
+			}
 
-				if (*curr == Char{ '\"' } || *curr == Char{ '\'' })
+			while (size < rows.size())
+			{
+				if (j_ == right_size_ && !forward())
 				{
-					tokens_[i++] = token_view{ curr, 1 };
-					for (char c{ *curr++ }; last != end && *last != c; ++last);
+					break;
 				}
 
-				auto len{ reinterpret_cast<std::size_t>(last) - reinterpret_cast<std::size_t>(curr) };
-				tokens_[i++] = token_view{ curr, len };
-
-				if (*last == Char{ '\"' } || *last == Char{ '\'' })
+				for (; j_ < right_size_ && size < rows.size(); ++j_, ++size)
 				{
-					tokens_[i++] = token_view{ last, 1 };
-					++last;
+					recr_copy(buffer_[size], block_[i_]);
+					join_type::copy_right(buffer_[size], *batch_[j_]);
+					rows[size] = &buffer_[size];
 				}
-
-				curr = last;
 			}
-		}
 
-		constexpr std::size_t count() const noexcept
-		{
-			return Count;
-		}
-
-		constexpr token_view* begin() noexcept
-		{
-			return tokens_.begin();
-		}
-		constexpr const token_view* cbegin() const noexcept
-		{
-			return tokens_.cbegin();
-		}
-
-		constexpr token_view* end() noexcept
-		{
-			return tokens_.end();
-		}
-		constexpr const token_view* cend() const noexcept
-		{
-			return tokens_.cend();
+			return size;
 		}
 
-		constexpr token_view& operator[](std::size_t i)
-		{
-			return tokens_[i];
-		}
-		constexpr token_view const& operator[](std::size_t i) const
+	private:
+		// empties both blocks so the first pair loads them
+		inline void restart() noexcept
 		{
-			return tokens_[i];
+			left_size_ = 0;
+			right_size_ = 0;
+			i_ = 0;
+			j_ = 0;
+			offset_ = 0;
 		}
 
-	private:
-		std::array<token_view, Count> tokens_;
-	};
-
-	template<typename Char, std::size_t N>
-	constexpr std::size_t preprocess(cexpr::string<Char, N> const& cs) noexcept
-	{
-		auto begin{ cs.cbegin() };
-		const auto end{ cs.cend() };
-		std::size_t count{ 1 };
-
-		while (begin < end)
+		// moves to the next left row of the block, then to the next right block, then to the next left block
+		//	over a rescanned right input, false once the left input is exhausted
+		bool forward()
 		{
-			begin = skip(begin, end);
-			begin = next(begin, end);
-			++count;
-		}
+			j_ = 0;
 
-		return count;
-	}
+			if (++i_ < left_size_)
+			{
+				return true;
+			}
 
-} // namespace sql
+			i_ = 0;
 
-namespace sql
-{
+			if (left_size_ != 0 && fetch())
+			{
+				return true;
+			}
 
-	namespace
-	{
+			rewind();
 
-		// shim to allow all value types like double or float to be used as non-type template parameters.
-		template <typename Type>
-		struct value
-		{
-			constexpr value(Type v) : val{ v }
-			{}
+			if (load() && fetch())
+			{
+				return true;
+			}
 
-			Type val;
-		};
+			left_size_ = 0;
 
-	} // namespace
+			return false;
+		}
 
-	template <cexpr::string Op, typename Row, typename Left, typename Right=void>
-	struct operation
-	{
-		static constexpr bool eval(Row const& row) noexcept
+		// copies up to Block left rows out of the output row, false when the left input is exhausted
+		bool load()
 		{
-			if constexpr (Op == "=")
-			{
-				return Left::eval(row) == Right::eval(row);
-			}
-			else if constexpr (Op == ">")
+			if (block_.size() < Block)
 			{
-				return Left::eval(row) > Right::eval(row);
+				block_.resize(Block);
 			}
-			else if constexpr(Op == "<")
+
+			for (left_size_ = 0; this->active_ && left_size_ < Block; this->advance())
 			{
-				return Left::eval(row) < Right::eval(row);
+				fold<sql::void_row, left_type>(block_[left_size_++], this->output_row_);
 			}
-			else if constexpr(Op == ">=")
+
+			return left_size_ != 0;
+		}
+
+		// points at the next block of right rows, streamed rows stay valid until the next batch is requested
+		bool fetch()
+		{
+			if constexpr (materialize)
 			{
-				return Left::eval(row) >= Right::eval(row);
+				right_size_ = std::min(Block, inputs_.size() - offset_);
+				batch_ = inputs_.data() + offset_;
+				offset_ += right_size_;
 			}
-			else if constexpr(Op == "<=")
+			else
 			{
-				return Left::eval(row) <= Right::eval(row);
+				if (inputs_.size() < Block)
+				{
+					inputs_.resize(Block);
+				}
+
+				right_size_ = this->right_.next_batch(std::span{ inputs_.data(), Block });
+				batch_ = inputs_.data();
 			}
-			else if constexpr(Op == "!=" || Op == "<>")
+
+			return right_size_ != 0;
+		}
+
+		// collects every right row, rows which do not outlive the next call to the right input are copied first
+		void drain()
+		{
+			inputs_.clear();
+
+			if constexpr (copy)
 			{
-				return Left::eval(row) != Right::eval(row);
+				copies_.clear();
+
+				for (auto const* row{ this->right_.next() }; row != nullptr; row = this->right_.next())
+				{
+					copies_.push_back(*row);
+				}
+
+				for (auto const& row : copies_)
+				{
+					inputs_.push_back(&row);
+				}
 			}
-			else if constexpr(Op == "AND")
+			else
 			{
-				return Left::eval(row) && Right::eval(row);
+				for (auto const* row{ this->right_.next() }; row != nullptr; row = this->right_.next())
+				{
+					inputs_.push_back(row);
+				}
 			}
-			else if constexpr(Op == "OR")
+		}
+
+		// starts the right rows over for the next left block
+		inline void rewind()
+		{
+			if constexpr (materialize)
 			{
-				return Left::eval(row) || Right::eval(row);
+				offset_ = 0;
 			}
-			else if constexpr(Op == "NOT")
+			else
 			{
-				return !Left::eval(row);
+				this->right_.reset();
 			}
 		}
-	};
-
-	template <cexpr::string Column, typename Row>
-	struct variable
-	{
-		static constexpr auto eval(Row const& row) noexcept
-		{
-			return sql::get<Column>(row);
-		}
-	};
 
-	template <auto Const, typename Row>
-	struct constant
-	{
-		static constexpr auto eval([[maybe_unused]] Row const& row) noexcept
-		{
-			return Const.val;
-		}
+		// the output row holds the left row after the block, so single rows are built apart from it
+		output_type row_{};
+		std::vector<left_type> block_{};
+		std::vector<right_input_type const*> inputs_{};
+		std::conditional_t<copy, std::vector<right_input_type>, sql::void_row> copies_{};
+		right_input_type const* const* batch_{};
+		std::vector<output_type> buffer_{};
+		std::size_t left_size_{};
+		std::size_t right_size_{};
+		std::size_t i_{};
+		std::size_t j_{};
+		std::size_t offset_{};
 	};
 
-} // namespace sql
+} // namespace ra
 
-namespace sql
+namespace ra
 {
 
-	// anonymous namespace to hold helper data structures and functions
 	namespace
 	{
 
-		template <std::size_t Pos, typename Node>
-		struct context
+		// type keying the groups of a GROUP BY on the Keys columns, a single column keys them by its value
+		template <typename Keys>
+		struct group_key
 		{
-			using node = Node;
-			static constexpr std::size_t pos = Pos;
+			using type = Keys;
 		};
 
-		template <typename Type, std::size_t Name, std::size_t Next>
-		struct colinfo
+		template <typename Col>
+		struct group_key<sql::row<Col, sql::void_row>>
 		{
-			using type = Type;
-			static constexpr std::size_t name = Name;
-			static constexpr std::size_t next = Next;
+			using type = typename Col::type;
 		};
 
-		template <cexpr::string Name, typename Row>
-		constexpr bool exists() noexcept
+	} // namespace
+
+	// base of the nodes grouping their input rows on the Keys columns, the Aggregates fold the rows of
+	//	a group into its state and compute the Output columns from it
+	template <typename Output, typename Keys, typename Aggregates, typename Input>
+	class aggregation;
+
+	template <typename Output, typename Keys, typename... Aggregates, typename Input>
+	class aggregation<Output, Keys, std::tuple<Aggregates...>, Input> : public ra::unary<Input>
+	{
+	protected:
+		using input_type = typename ra::unary<Input>::input_type;
+		using key_type = typename group_key<Keys>::type;
+		using state_type = std::tuple<typename Aggregates::state...>;
+
+	public:
+		using output_type = Output;
+
+	protected:
+		// key of the group a row belongs to, a single grouped column is read in place
+		static inline decltype(auto) key(input_type const& row)
 		{
-			if constexpr (std::is_same_v<Row, sql::void_row>)
+			if constexpr (Keys::depth == 1)
 			{
-				return false;
+				return sql::get<Keys::column::name>(row);
 			}
 			else
 			{
-				if constexpr (Row::column::name == Name)
-				{
-					return true;
-				}
-				else
-				{
-					return exists<Name, typename Row::next>();
-				}
+				Keys keys{};
+				copy<Keys>(keys, row);
+
+				return keys;
 			}
 		}
 
-		template <typename Type, typename Char, std::size_t N>
-		constexpr value<Type> convert(cexpr::string<Char, N> const& str) noexcept
+		static inline void init(state_type& state, input_type const& row)
 		{
-			auto curr{ str.cbegin() }, end{ str.cend() };
-			constexpr Char dot{ '.' }, zro{ '0' }, min{ '-' };
-			Type acc{}, sign{ 1 }, scalar{ 10 };
+			init(state, row, std::index_sequence_for<Aggregates...>{});
+		}
 
-			if (*curr == min)
-			{
-				sign = -1;
-				++curr;
-			}
+		static inline void update(state_type& state, input_type const& row)
+		{
+			update(state, row, std::index_sequence_for<Aggregates...>{});
+		}
 
-			while (curr != end && *curr != dot)
-			{
-				acc = (acc * scalar) + (*curr - zro);
-				++curr;
+		static inline void emit(output_type& dest, state_type const& state)
+		{
+			emit<0>(dest, state);
+		}
+
+	private:
+		template <typename Dest>
+		static inline void copy(Dest& dest, input_type const& src)
+		{
+			if constexpr (Dest::depth != 0)
+			{
+				dest.head() = sql::get<Dest::column::name>(src);
+				copy<typename Dest::next>(dest.tail(), src);
+			}
+		}
+
+		template <std::size_t... Ids>
+		static inline void init(state_type& state, input_type const& row, std::index_sequence<Ids...>)
+		{
+			(Aggregates::init(std::get<Ids>(state), row), ...);
+		}
+
+		template <std::size_t... Ids>
+		static inline void update(state_type& state, input_type const& row, std::index_sequence<Ids...>)
+		{
+			(Aggregates::update(std::get<Ids>(state), row), ...);
+		}
+
+		template <std::size_t Id, typename Dest>
+		static inline void emit(Dest& dest, state_type const& state)
+		{
+			if constexpr (Dest::depth != 0)
+			{
+				dest.head() = std::tuple_element_t<Id, std::tuple<Aggregates...>>::result(std::get<Id>(state));
+				emit<Id + 1>(dest.tail(), state);
+			}
+		}
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	// open addressing set which numbers its distinct keys from one in insertion order, zero marks an absent key
+	template <typename Key, typename Hash = std::hash<Key>>
+	class key_index
+	{
+	public:
+		// id of key, which is numbered after the keys inserted before it when it is not present
+		std::size_t insert(Key const& key)
+		{
+			auto const hash{ Hash{}(key) };
+			auto id{ lookup(key, hash) };
+
+			if (id == 0)
+			{
+				if ((keys_.size() + 1) * 2 > slots_.size())
+				{
+					grow();
+				}
+
+				keys_.push_back(key);
+				id = keys_.size();
+				place(hash, id);
+			}
+
+			return id;
+		}
+
+		inline std::size_t find(Key const& key) const
+		{
+			return lookup(key, Hash{}(key));
+		}
+
+		// keys in the order they were numbered, the key of id is at id - 1
+		inline std::span<Key const> keys() const noexcept
+		{
+			return keys_;
+		}
+
+		inline bool empty() const noexcept
+		{
+			return keys_.empty();
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return keys_.size();
+		}
+
+	private:
+		struct slot
+		{
+			std::size_t hash;
+			std::size_t id;
+		};
+
+		// fibonacci hashing spreads weak hashes (like identity hashes of integers) over the slots
+		inline std::size_t home(std::size_t hash) const noexcept
+		{
+			return (hash * 0x9E3779B97F4A7C15ull) >> shift_;
+		}
+
+		std::size_t lookup(Key const& key, std::size_t hash) const
+		{
+			if (slots_.empty())
+			{
+				return 0;
+			}
+
+			auto const mask{ slots_.size() - 1 };
+
+			for (auto i{ home(hash) }; slots_[i].id != 0; i = (i + 1) & mask)
+			{
+				if (slots_[i].hash == hash && keys_[slots_[i].id - 1] == key)
+				{
+					return slots_[i].id;
+				}
+			}
+
+			return 0;
+		}
+
+		void place(std::size_t hash, std::size_t id) noexcept
+		{
+			auto const mask{ slots_.size() - 1 };
+			auto i{ home(hash) };
+
+			while (slots_[i].id != 0)
+			{
+				i = (i + 1) & mask;
+			}
+
+			slots_[i] = slot{ hash, id };
+		}
+
+		// doubles the slot array keeping the load factor at or below one half
+		void grow()
+		{
+			auto old{ std::move(slots_) };
+			slots_ = std::vector<slot>(old.empty() ? 16 : old.size() * 2, slot{ 0, 0 });
+			shift_ = sizeof(std::size_t) * 8;
+
+			for (auto size{ slots_.size() }; size > 1; size >>= 1)
+			{
+				--shift_;
+			}
+
+			for (auto const& s : old)
+			{
+				if (s.id != 0)
+				{
+					place(s.hash, s.id);
+				}
+			}
+		}
+
+		std::vector<slot> slots_{};
+		std::vector<Key> keys_{};
+		std::size_t shift_{};
+	};
+
+	// open addressing multimap which is built once and then probed, the values of each key are
+	//	stored contiguously in insertion order and probing never inserts
+	template <typename Key, typename Value, typename Hash = std::hash<Key>>
+	class hash_table
+	{
+	public:
+		// stages a default constructed value under key, staged values are found once build is called
+		Value& emplace(Key const& key)
+		{
+			auto const id{ index_.insert(key) };
+
+			if (id == offsets_.size())
+			{
+				offsets_.push_back(0);
+			}
+
+			++offsets_[id];
+			staged_.emplace_back(id, Value{});
+
+			return staged_.back().second;
+		}
+
+		// lays the staged values out grouped by key
+		void build()
+		{
+			for (std::size_t id{ 1 }; id < offsets_.size(); ++id)
+			{
+				offsets_[id] += offsets_[id - 1];
+			}
+
+			std::vector<std::size_t> cursor(offsets_.begin(), offsets_.end() - 1);
+			values_.resize(staged_.size());
+
+			for (auto& [id, value] : staged_)
+			{
+				values_[cursor[id - 1]++] = std::move(value);
+			}
+
+			staged_ = {};
+		}
+
+		// values stored under key, empty when the key is not present
+		std::span<Value const> find(Key const& key) const
+		{
+			auto const id{ index_.find(key) };
+
+			if (id == 0)
+			{
+				return {};
+			}
+			else
+			{
+				return { values_.data() + offsets_[id - 1], offsets_[id] - offsets_[id - 1] };
+			}
+		}
+
+		// every value in the table, the values of a key are a sub span of these
+		inline std::span<Value const> values() const noexcept
+		{
+			return values_;
+		}
+
+		inline bool empty() const noexcept
+		{
+			return index_.empty();
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return values_.size();
+		}
+
+	private:
+		ra::key_index<Key, Hash> index_{};
+		std::vector<std::size_t> offsets_{ 0 };
+		std::vector<Value> values_{};
+		std::vector<std::pair<std::size_t, Value>> staged_{};
+	};
+
+	// the last table built for Owner, shared by every node of that type while the generation of the rows it
+	//	was built from is unchanged, build fills a new table once the generation moves on
+	template <typename Owner, typename Table>
+	class shared_table
+	{
+	public:
+		template <typename Build>
+		static std::shared_ptr<Table const> fetch(std::size_t generation, Build&& build)
+		{
+			// untracked rows can change without notice, so their tables are never shared
+			if (generation == 0)
+			{
+				auto table{ std::make_shared<Table>() };
+				build(*table);
+
+				return table;
+			}
+
+			std::lock_guard<std::mutex> lock{ mutex_ };
+
+			if (table_ == nullptr || generation_ != generation)
+			{
+				auto table{ std::make_shared<Table>() };
+				build(*table);
+				table_ = std::move(table);
+				generation_ = generation;
+			}
+
+			return table_;
+		}
+
+	private:
+		static inline std::mutex mutex_{};
+		static inline std::shared_ptr<Table const> table_{};
+		static inline std::size_t generation_{};
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	// hash aggregation grouping the input rows on their Keys columns, the Aggregates compute the Output
+	//	columns of each group, the input is drained into one state per group when the node is seeded,
+	//	without Keys every row belongs to the one group which is output even when the input is empty
+	template <typename Output, typename Keys, typename Aggregates, typename Input>
+	class group : public ra::aggregation<Output, Keys, Aggregates, Input>
+	{
+		using base_type = ra::aggregation<Output, Keys, Aggregates, Input>;
+		using input_type = typename base_type::input_type;
+		using key_type = typename base_type::key_type;
+		using state_type = typename base_type::state_type;
+
+		static constexpr std::size_t batch_size{ 1024 };
+	public:
+		using output_type = Output;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			this->input_.seed(rs...);
+			index_ = {};
+			states_.clear();
+			curr_ = 0;
+
+			if constexpr (Keys::depth == 0)
+			{
+				states_.emplace_back();
+			}
+
+			std::vector<input_type const*> rows(batch_size);
+
+			for (auto count{ this->input_.next_batch(std::span{ rows }) }; count != 0; count = this->input_.next_batch(std::span{ rows }))
+			{
+				for (std::size_t i{}; i < count; ++i)
+				{
+					accumulate(*rows[i]);
+				}
+			}
+		}
+
+		// replays the groups, the input is only drained again when the node is seeded
+		inline void reset() noexcept
+		{
+			curr_ = 0;
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return states_.size();
+		}
+
+		// groups are output in the order their first rows were read
+		output_type const* next()
+		{
+			if (curr_ < states_.size())
+			{
+				base_type::emit(output_row_, states_[curr_++]);
+
+				return &output_row_;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			std::size_t size{};
+
+			for (; size < rows.size() && curr_ < states_.size(); ++size, ++curr_)
+			{
+				base_type::emit(buffer_[size], states_[curr_]);
+				rows[size] = &buffer_[size];
+			}
+
+			return size;
+		}
+
+	private:
+		inline void accumulate(input_type const& row)
+		{
+			if constexpr (Keys::depth == 0)
+			{
+				base_type::update(states_.front(), row);
+			}
+			else
+			{
+				auto const id{ index_.insert(base_type::key(row)) };
+
+				if (id > states_.size())
+				{
+					base_type::init(states_.emplace_back(), row);
+				}
+				else
+				{
+					base_type::update(states_[id - 1], row);
+				}
+			}
+		}
+
+		ra::key_index<key_type> index_{};
+		std::vector<state_type> states_{};
+		std::size_t curr_{};
+		output_type output_row_{};
+		std::vector<output_type> buffer_{};
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	// index nested loop join, the right input is narrowed to the rows matching each left row's key
+	//	through its schema index so no build side table is held
+	template <typename LeftInput, typename RightInput, cexpr::string LeftKey, cexpr::string RightKey,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>>
+	class indexed : public ra::join<LeftInput, RightInput, Left, Right>
+	{
+		using join_type = ra::join<LeftInput, RightInput, Left, Right>;
+
+		static_assert(sql::exists<LeftKey, typename join_type::left_type>(), "Left join key must be carried into the output row.");
+	public:
+		using output_type = join_type::output_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+			seek();
+		}
+
+		void reset()
+		{
+			join_type::reset();
+			seek();
+		}
+
+		output_type const* next()
+		{
+			while (this->active_)
+			{
+				auto const* row{ this->right_.next() };
+
+				if (row != nullptr)
+				{
+					join_type::copy_right(this->output_row_, *row);
+
+					return &this->output_row_;
+				}
+
+				this->advance();
+				seek();
+			}
+
+			return nullptr;
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+				inputs_.resize(rows.size());
+			}
+
+			while (this->active_ && size < rows.size())
+			{
+				auto const count{ this->right_.next_batch(std::span{ inputs_.data(), rows.size() - size }) };
+
+				if (count == 0)
+				{
+					this->advance();
+					seek();
+
+					continue;
+				}
+
+				for (std::size_t i{}; i < count; ++i, ++size)
+				{
+					buffer_[size] = this->output_row_;
+					join_type::copy_right(buffer_[size], *inputs_[i]);
+					rows[size] = &buffer_[size];
+				}
+			}
+
+			return size;
+		}
+
+	private:
+		// points the right input at the rows with the key of the current left row
+		inline void seek()
+		{
+			if (this->active_)
+			{
+				this->right_.template seek<RightKey>(sql::get<LeftKey>(this->output_row_));
+			}
+		}
+
+		std::vector<output_type> buffer_{};
+		std::vector<typename join_type::right_input_type const*> inputs_{};
+	};
+
+} // namespace ra
+
+namespace sql
+{
+
+	namespace
+	{
+
+		// shim to allow all value types like double or float to be used as non-type template parameters.
+		template <typename Type>
+		struct value
+		{
+			constexpr value(Type v) : val{ v }
+			{}
+
+			Type val;
+		};
+
+		// rebinds a predicate node to evaluate over another row type, void stays void
+		template <typename Node, typename Row>
+		struct rebound
+		{
+			using type = typename Node::template rebind<Row>;
+		};
+
+		template <typename Row>
+		struct rebound<void, Row>
+		{
+			using type = void;
+		};
+
+		// false for null values of nullable columns
+		template <typename Type>
+		constexpr bool known([[maybe_unused]] Type const& val) noexcept
+		{
+			if constexpr (nullable_type<Type>::value)
+			{
+				return val.has_value();
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		// value held by a nullable column, other values are returned as is
+		template <typename Type>
+		constexpr auto const& unwrap(Type const& val) noexcept
+		{
+			if constexpr (nullable_type<Type>::value)
+			{
+				return *val;
+			}
+			else
+			{
+				return val;
+			}
+		}
+
+		template <cexpr::string Op, typename Left, typename Right>
+		constexpr bool compare(Left const& left, Right const& right) noexcept
+		{
+			if constexpr (Op == "=")
+			{
+				return left == right;
+			}
+			else if constexpr (Op == ">")
+			{
+				return left > right;
+			}
+			else if constexpr(Op == "<")
+			{
+				return left < right;
+			}
+			else if constexpr(Op == ">=")
+			{
+				return left >= right;
+			}
+			else if constexpr(Op == "<=")
+			{
+				return left <= right;
+			}
+			else
+			{
+				return left != right;
+			}
+		}
+
+	} // namespace
+
+	template <cexpr::string Op, typename Row, typename Left, typename Right=void>
+	struct operation
+	{
+		// the same predicate evaluated over rows of type Other
+		template <typename Other>
+		using rebind = operation<Op, Other, typename rebound<Left, Other>::type, typename rebound<Right, Other>::type>;
+
+		// true when the predicate holds, comparisons with a null column are neither true nor false
+		static constexpr bool eval(Row const& row) noexcept
+		{
+			if constexpr (Op == "AND")
+			{
+				return Left::eval(row) && Right::eval(row);
+			}
+			else if constexpr (Op == "OR")
+			{
+				return Left::eval(row) || Right::eval(row);
+			}
+			else if constexpr (Op == "NOT")
+			{
+				return Left::refute(row);
+			}
+			else
+			{
+				auto const& left{ Left::eval(row) };
+				auto const& right{ Right::eval(row) };
+
+				return known(left) && known(right) && compare<Op>(unwrap(left), unwrap(right));
+			}
+		}
+
+		// true when the predicate is false, which only differs from !eval when a null column is compared
+		static constexpr bool refute(Row const& row) noexcept
+		{
+			if constexpr (Op == "AND")
+			{
+				return Left::refute(row) || Right::refute(row);
+			}
+			else if constexpr (Op == "OR")
+			{
+				return Left::refute(row) && Right::refute(row);
+			}
+			else if constexpr (Op == "NOT")
+			{
+				return Left::eval(row);
+			}
+			else
+			{
+				auto const& left{ Left::eval(row) };
+				auto const& right{ Right::eval(row) };
+
+				return known(left) && known(right) && !compare<Op>(unwrap(left), unwrap(right));
+			}
+		}
+
+		// true when evaluating the predicate reads the column Name
+		template <cexpr::string Name>
+		static constexpr bool reads() noexcept
+		{
+			if constexpr (std::is_void_v<Right>)
+			{
+				return Left::template reads<Name>();
+			}
+			else
+			{
+				return Left::template reads<Name>() || Right::template reads<Name>();
+			}
+		}
+	};
+
+	template <cexpr::string Column, typename Row>
+	struct variable
+	{
+		template <typename Other>
+		using rebind = variable<Column, Other>;
+
+		// the column is read in place, so comparing a string column copies no string
+		static constexpr decltype(auto) eval(Row const& row) noexcept
+		{
+			return sql::get<Column>(row);
+		}
+
+		static constexpr bool refute(Row const& row) noexcept
+		{
+			return !eval(row);
+		}
+
+		template <cexpr::string Name>
+		static constexpr bool reads() noexcept
+		{
+			return Column == Name;
+		}
+	};
+
+	template <auto Const, typename Row>
+	struct constant
+	{
+		template <typename Other>
+		using rebind = constant<Const, Other>;
+
+		static constexpr auto eval([[maybe_unused]] Row const& row) noexcept
+		{
+			return Const.val;
+		}
+
+		static constexpr bool refute(Row const& row) noexcept
+		{
+			return !eval(row);
+		}
+
+		template <cexpr::string Name>
+		static constexpr bool reads() noexcept
+		{
+			return false;
+		}
+	};
+
+} // namespace sql
+
+namespace ra
+{
+
+	// hash equi join of the LeftKey column of the left input with the RightKey column of the right input,
+	//	Build chooses the input the hash table is built over and the other input is streamed over it
+	template <typename LeftInput, typename RightInput, cexpr::string LeftKey, cexpr::string RightKey,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>,
+		ra::side Build = ra::side::right>
+	class inner : public ra::join<LeftInput, RightInput, Left, Right>
+	{
+		using join_type = ra::join<LeftInput, RightInput, Left, Right>;
+		using left_type = typename join_type::left_type;
+		using right_type = typename join_type::right_type;
+		using left_key = std::remove_cvref_t<decltype(sql::get<LeftKey>(typename join_type::left_input_type{}))>;
+		using right_key = std::remove_cvref_t<decltype(sql::get<RightKey>(typename join_type::right_input_type{}))>;
+
+		// hash table built over the Side input and the cursor into its rows matching the current probe row, keyed on
+		//	the values of nullable keys since null keys match no row
+		template <ra::side Side>
+		struct cache
+		{
+			using key_type = typename sql::nullable_type<std::conditional_t<Side == ra::side::right, right_key, left_key>>::type::value_type;
+			using value_type = std::conditional_t<Side == ra::side::right, decltype(remainder<left_type, right_type>()), left_type>;
+			using table_type = ra::hash_table<key_type, value_type>;
+
+			std::shared_ptr<table_type const> table{};
+			value_type const* curr{};
+			value_type const* end{};
+		};
+
+		static_assert(sql::exists<LeftKey, left_type>(), "Left join key must be carried into the output row.");
+	public:
+		using output_type = join_type::output_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+
+			if constexpr (Build == ra::side::smaller)
+			{
+				// ties build over the right input so the left input keeps streaming in order
+				build_left_ = this->left_.size() < this->right_.size();
+
+				if (build_left_)
+				{
+					start<ra::side::left>();
+				}
+				else
+				{
+					start<ra::side::right>();
+				}
+			}
+			else
+			{
+				start<Build>();
+			}
+		}
+
+		void reset()
+		{
+			join_type::reset();
+
+			if constexpr (Build != ra::side::smaller)
+			{
+				match<Build>();
+			}
+			else if (build_left_)
+			{
+				match<ra::side::left>();
+			}
+			else
+			{
+				match<ra::side::right>();
+			}
+		}
+
+		output_type const* next()
+		{
+			if constexpr (Build != ra::side::smaller)
+			{
+				return step<Build>();
+			}
+			else if (build_left_)
+			{
+				return step<ra::side::left>();
+			}
+			else
+			{
+				return step<ra::side::right>();
+			}
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if constexpr (Build != ra::side::smaller)
+			{
+				return batch<Build>(rows);
+			}
+			else if (build_left_)
+			{
+				return batch<ra::side::left>(rows);
+			}
+			else
+			{
+				return batch<ra::side::right>(rows);
+			}
+		}
+
+	private:
+		template <ra::side Side>
+		inline cache<Side>& cached() noexcept
+		{
+			if constexpr (Side == ra::side::left)
+			{
+				return left_cache_;
+			}
+			else
+			{
+				return right_cache_;
+			}
+		}
+
+		// takes the hash table over the Side input, which is only built when no node of this type has
+		//	built one over the current generation of its rows, and points at the first matches
+		template <ra::side Side>
+		inline void start()
+		{
+			using table_type = typename cache<Side>::table_type;
+
+			auto const generation{ Side == ra::side::right ? this->right_.generation() : this->left_.generation() };
+
+			auto fill = [this](table_type& table)
+			{
+				build<Side>(table);
+			};
+
+			cached<Side>().table = ra::shared_table<cache<Side>, table_type>::fetch(generation, fill);
+
+			match<Side>();
+		}
+
+		template <ra::side Side>
+		inline output_type const* step()
+		{
+			auto& cache{ cached<Side>() };
+
+			while (cache.curr == cache.end)
+			{
+				if (!probe<Side>())
+				{
+					return nullptr;
+				}
+			}
+
+			place<Side>(this->output_row_, *cache.curr++);
+
+			return &this->output_row_;
+		}
+
+		template <ra::side Side>
+		std::size_t batch(std::span<output_type const*> rows)
+		{
+			auto& cache{ cached<Side>() };
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			while (size < rows.size())
+			{
+				if (cache.curr == cache.end)
+				{
+					if (!probe<Side>())
+					{
+						break;
+					}
+				}
+				else
+				{
+					buffer_[size] = this->output_row_;
+					place<Side>(buffer_[size], *cache.curr++);
+					rows[size] = &buffer_[size];
+					++size;
+				}
+			}
+
+			return size;
+		}
+
+		// drains the build input into the hash table, the left input arrives through the output row
+		template <ra::side Side>
+		void build(typename cache<Side>::table_type& table)
+		{
+			using value_type = typename cache<Side>::value_type;
+
+			if constexpr (Side == ra::side::right)
+			{
+				for (auto const* row{ this->right_.next() }; row != nullptr; row = this->right_.next())
+				{
+					if (auto const& key{ sql::get<RightKey>(*row) }; sql::known(key))
+					{
+						fold<sql::void_row, value_type>(table.emplace(sql::unwrap(key)), *row);
+					}
+				}
+
+				this->right_.reset();
+			}
+			else
+			{
+				for (bool row{ this->active_ }; row; row = this->advance())
+				{
+					if (auto const& key{ sql::get<LeftKey>(this->output_row_) }; sql::known(key))
+					{
+						fold<sql::void_row, value_type>(table.emplace(sql::unwrap(key)), this->output_row_);
+					}
+				}
+			}
+
+			table.build();
+		}
+
+		// points the cursor at the cached rows matching the current probe row
+		template <ra::side Side>
+		inline void match()
+		{
+			auto& cache{ cached<Side>() };
+
+			if constexpr (Side == ra::side::right)
+			{
+				if (this->active_ && sql::known(sql::get<LeftKey>(this->output_row_)))
+				{
+					auto const rows{ cache.table->find(sql::unwrap(sql::get<LeftKey>(this->output_row_))) };
+					cache.curr = rows.data();
+					cache.end = rows.data() + rows.size();
+				}
+				else
+				{
+					cache.curr = cache.end;
+				}
+			}
+			else
+			{
+				cache.curr = cache.end;
+			}
+		}
+
+		// moves to the next row of the streamed input, false once it is exhausted
+		template <ra::side Side>
+		inline bool probe()
+		{
+			if constexpr (Side == ra::side::right)
+			{
+				if (!this->advance())
+				{
+					return false;
+				}
+
+				match<Side>();
+			}
+			else
+			{
+				auto const* row{ this->right_.next() };
+
+				if (row == nullptr)
+				{
+					return false;
+				}
+
+				auto& cache{ cached<Side>() };
+
+				if (auto const& key{ sql::get<RightKey>(*row) }; sql::known(key))
+				{
+					auto const rows{ cache.table->find(sql::unwrap(key)) };
+					cache.curr = rows.data();
+					cache.end = rows.data() + rows.size();
+				}
+				else
+				{
+					cache.curr = cache.end;
+				}
+
+				if (cache.curr != cache.end)
+				{
+					join_type::copy_right(this->output_row_, *row);
+				}
+			}
+
+			return true;
+		}
+
+		// copies a cached row into its place in the output row
+		template <ra::side Side>
+		static inline void place(output_type& dest, typename cache<Side>::value_type const& src)
+		{
+			if constexpr (Side == ra::side::right)
+			{
+				copy_after<left_type>(dest, src);
+			}
+			else
+			{
+				recr_copy(dest, src);
+			}
+		}
+
+		std::conditional_t<Build == ra::side::right, sql::void_row, cache<ra::side::left>> left_cache_{};
+		std::conditional_t<Build == ra::side::left, sql::void_row, cache<ra::side::right>> right_cache_{};
+		std::vector<output_type> buffer_{};
+		bool build_left_{};
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	// first Limit input rows after the first Offset, the input is no longer pulled once Limit rows were output
+	//	and is never seeded when Limit is zero, so nodes which do their work when seeded (like building a hash
+	//	table) skip it, Skip inputs output one row per row of a scan and jump past the Offset rows without reading them
+	template <std::size_t Limit, std::size_t Offset, bool Skip, typename Input>
+	class limit : public ra::unary<Input>
+	{
+		using input_type = typename ra::unary<Input>::input_type;
+	public:
+		using output_type = input_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			if constexpr (Limit != 0)
+			{
+				this->input_.seed(rs...);
+			}
+
+			count_ = 0;
+			skipped_ = false;
+		}
+
+		void reset()
+		{
+			if constexpr (Limit != 0)
+			{
+				this->input_.reset();
+			}
+
+			count_ = 0;
+			skipped_ = false;
+		}
+
+		// rows of the seeded input, an upper bound of the rows output
+		inline std::size_t size() const
+		{
+			if constexpr (Limit == 0)
+			{
+				return 0;
+			}
+			else
+			{
+				return std::min(Limit, this->input_.size());
+			}
+		}
+
+		// an unseeded input has no rows to track
+		inline std::size_t generation() const
+		{
+			if constexpr (Limit == 0)
+			{
+				return 0;
+			}
+			else
+			{
+				return this->input_.generation();
+			}
+		}
+
+		output_type const* next()
+		{
+			if (count_ == Limit || !skip())
+			{
+				return nullptr;
+			}
+
+			auto const* row{ this->input_.next() };
+
+			if (row != nullptr)
+			{
+				++count_;
+			}
+
+			return row;
+		}
+
+		// fills at most the rows left to output, so the input never produces rows past the limit
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (count_ == Limit || !skip())
+			{
+				return 0;
+			}
+
+			auto const size{ this->input_.next_batch(rows.first(std::min(rows.size(), Limit - count_))) };
+			count_ += size;
+
+			return size;
+		}
+
+	private:
+		// passes over the Offset rows before the first row output, false when the input ended among them
+		inline bool skip()
+		{
+			if constexpr (Offset != 0)
+			{
+				if (!skipped_)
+				{
+					std::size_t size{};
+
+					if constexpr (Skip)
+					{
+						size = this->input_.skip(Offset);
+					}
+					else
+					{
+						while (size < Offset && this->input_.next() != nullptr)
+						{
+							++size;
+						}
+					}
+
+					skipped_ = true;
+
+					if (size < Offset)
+					{
+						count_ = Limit;
+
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		std::size_t count_{};
+		bool skipped_{};
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	// hash join on the leading column of each input, Build chooses the input the hash table is built over
+	template <typename LeftInput, typename RightInput,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>,
+		ra::side Build = ra::side::right>
+	class natural : public ra::inner<LeftInput, RightInput,
+		std::remove_cvref_t<typename LeftInput::output_type>::column::name,
+		std::remove_cvref_t<typename RightInput::output_type>::column::name, Left, Right, Build>
+	{};
+
+} // namespace ra
+
+namespace ra
+{
+
+	// hash outer join of the LeftKey column of the left input with the RightKey column of the right input,
+	//	rows of the kept inputs without a match are emitted once with the columns of the other input null
+	template <typename LeftInput, typename RightInput, cexpr::string LeftKey, cexpr::string RightKey,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>,
+		ra::keep Keep = ra::keep::left>
+	class outer : public ra::join<LeftInput, RightInput,
+		std::conditional_t<Keep == ra::keep::left, Left, decltype(padded<Left>())>,
+		std::conditional_t<Keep == ra::keep::right, Right, decltype(padded<Right>())>>
+	{
+		using join_type = ra::join<LeftInput, RightInput,
+			std::conditional_t<Keep == ra::keep::left, Left, decltype(padded<Left>())>,
+			std::conditional_t<Keep == ra::keep::right, Right, decltype(padded<Right>())>>;
+		using left_type = typename join_type::left_type;
+		using right_type = typename join_type::right_type;
+
+		// right outer joins build over the left input so the right input streams in order
+		static constexpr bool build_left{ Keep == ra::keep::right };
+
+		using left_key = std::remove_cvref_t<decltype(sql::get<LeftKey>(typename join_type::left_input_type{}))>;
+		using right_key = std::remove_cvref_t<decltype(sql::get<RightKey>(typename join_type::right_input_type{}))>;
+		using key_type = std::conditional_t<build_left, left_key, right_key>;
+		using value_type = std::conditional_t<build_left, left_type, decltype(remainder<left_type, right_type>())>;
+		using table_type = ra::hash_table<key_type, value_type>;
+
+		static_assert(sql::exists<LeftKey, left_type>(), "Left join key must be carried into the output row.");
+	public:
+		using output_type = join_type::output_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+
+			// the hash table is only built when no node of this type has built one over the current
+			//	generation of the build input's rows
+			auto const generation{ build_left ? this->left_.generation() : this->right_.generation() };
+
+			auto fill = [this](table_type& table)
+			{
+				build(table);
+			};
+
+			row_cache_ = ra::shared_table<outer, table_type>::fetch(generation, fill);
+			restart();
+		}
+
+		void reset()
+		{
+			join_type::reset();
+			restart();
+		}
+
+		output_type const* next()
+		{
+			while (true)
+			{
+				if (curr_ != end_)
+				{
+					if constexpr (Keep == ra::keep::both)
+					{
+						seen_[curr_ - row_cache_->values().data()] = true;
+					}
+
+					place(this->output_row_, *curr_++);
+
+					return &this->output_row_;
+				}
+				else if (pad_)
+				{
+					pad_ = false;
+					place(this->output_row_, value_type{});
+
+					return &this->output_row_;
+				}
+				else if (!probe())
+				{
+					break;
+				}
+			}
+
+			if constexpr (Keep == ra::keep::both)
+			{
+				return unmatched();
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		// outer joins emit through next, batches are buffered copies of its rows
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			for (auto const* row{ size < rows.size() ? next() : nullptr }; row != nullptr; row = size < rows.size() ? next() : nullptr)
+			{
+				buffer_[size] = *row;
+				rows[size] = &buffer_[size];
+				++size;
+			}
+
+			return size;
+		}
+
+	private:
+		// drains the build input into the hash table, the left input arrives through the output row
+		void build(table_type& table)
+		{
+			if constexpr (build_left)
+			{
+				for (bool row{ this->active_ }; row; row = this->advance())
+				{
+					fold<sql::void_row, value_type>(table.emplace(current()), this->output_row_);
+				}
+			}
+			else
+			{
+				for (auto const* row{ this->right_.next() }; row != nullptr; row = this->right_.next())
+				{
+					fold<sql::void_row, value_type>(table.emplace(sql::get<RightKey>(*row)), *row);
+				}
+
+				this->right_.reset();
+			}
+
+			table.build();
+		}
+
+		// positions the node before its first output row
+		inline void restart()
+		{
+			if constexpr (Keep == ra::keep::both)
+			{
+				seen_.assign(row_cache_->size(), false);
+				index_ = 0;
+			}
+
+			if constexpr (build_left)
+			{
+				curr_ = end_;
+				pad_ = false;
+			}
+			else if (this->active_)
+			{
+				match(current());
+			}
+			else
+			{
+				curr_ = end_;
+				pad_ = false;
+			}
+		}
+
+		// points the cursor at the cached rows matching key, a probe row without any is padded, null keys match
+		//	no row but the null keys of the build input are kept so a full join emits their rows
+		template <typename Key>
+		inline void match(Key const& key)
+		{
+			if (sql::known(key))
+			{
+				auto const rows{ find(key) };
+				curr_ = rows.data();
+				end_ = rows.data() + rows.size();
+				pad_ = rows.empty();
+			}
+			else
+			{
+				curr_ = end_;
+				pad_ = true;
+			}
+		}
+
+		template <typename Key>
+		inline auto find(Key const& key) const
+		{
+			if constexpr (std::is_same_v<Key, key_type>)
+			{
+				return row_cache_->find(key);
+			}
+			else if constexpr (sql::nullable_type<key_type>::value)
+			{
+				return row_cache_->find(key_type{ key });
+			}
+			else
+			{
+				return row_cache_->find(sql::unwrap(key));
+			}
+		}
+
+		// moves to the next row of the streamed input, false once it is exhausted
+		inline bool probe()
+		{
+			if constexpr (build_left)
+			{
+				auto const* row{ this->right_.next() };
+
+				if (row == nullptr)
+				{
+					return false;
+				}
+
+				join_type::copy_right(this->output_row_, *row);
+				match(sql::get<RightKey>(*row));
+			}
+			else
+			{
+				if (!this->advance())
+				{
+					return false;
+				}
+
+				match(current());
+			}
+
+			return true;
+		}
+
+		// key of the left row in the output row, padded left columns are never null while reading the left input
+		//	unless the left input's key is itself nullable
+		inline left_key const& current() const noexcept
+		{
+			if constexpr (Keep == ra::keep::left || sql::nullable_type<left_key>::value)
+			{
+				return sql::get<LeftKey>(this->output_row_);
+			}
+			else
+			{
+				return *sql::get<LeftKey>(this->output_row_);
+			}
+		}
+
+		// right rows of a full join which matched no left row, emitted once the left input is exhausted
+		output_type const* unmatched()
+		{
+			auto const values{ row_cache_->values() };
+
+			while (index_ < values.size())
+			{
+				auto const i{ index_++ };
+
+				if (!seen_[i])
+				{
+					recr_copy(this->output_row_, left_type{});
+					place(this->output_row_, values[i]);
+
+					return &this->output_row_;
+				}
+			}
+
+			return nullptr;
+		}
+
+		// copies a cached row, or the nulls of a padded row, into its place in the output row
+		static inline void place(output_type& dest, value_type const& src)
+		{
+			if constexpr (build_left)
+			{
+				recr_copy(dest, src);
+			}
+			else
+			{
+				copy_after<left_type>(dest, src);
+			}
+		}
+
+		std::shared_ptr<table_type const> row_cache_{};
+		std::vector<output_type> buffer_{};
+		std::conditional_t<Keep == ra::keep::both, std::vector<bool>, sql::void_row> seen_{};
+		std::size_t index_{};
+		value_type const* curr_{};
+		value_type const* end_{};
+		bool pad_{};
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	template <typename Output, typename Input>
+	class projection : public ra::unary<Input>
+	{
+		using input_type =  typename ra::unary<Input>::input_type;
+	public:
+		using output_type = Output;
+
+		output_type const* next()
+		{
+			auto const* row{ this->input_.next() };
+
+			if (row != nullptr)
+			{
+				fold<output_type>(output_row_, *row);
+
+				return &output_row_;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+				inputs_.resize(rows.size());
+			}
+
+			auto const size{ this->input_.next_batch(std::span{ inputs_.data(), rows.size() }) };
+
+			for (std::size_t i{}; i < size; ++i)
+			{
+				fold<output_type>(buffer_[i], *inputs_[i]);
+				rows[i] = &buffer_[i];
+			}
+
+			return size;
+		}
+
+		// each input row is one output row, so skipping rows skips as many input rows
+		inline std::size_t skip(std::size_t count)
+		{
+			return this->input_.skip(count);
+		}
+
+	private:
+		template <typename Dest>
+		static inline constexpr void fold(Dest& dest, input_type const& src)
+		{
+			if constexpr (Dest::depth == 0)
+			{
+				return;
+			}
+			else
+			{
+				dest.head() = sql::get<Dest::column::name>(src);
+				fold<typename Dest::next>(dest.tail(), src);	
+			}
+		}
+
+		output_type output_row_{};
+		std::vector<output_type> buffer_{};
+		std::vector<input_type const*> inputs_{};
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	template <typename Output, typename Input>
+	class rename : public ra::unary<Input>
+	{
+		using input_type = typename ra::unary<Input>::input_type;
+	public:
+		using output_type = Output;
+
+		output_type const* next()
+		{
+			auto const* row{ this->input_.next() };
+
+			if (row != nullptr)
+			{
+				fold<output_type, input_type>(output_row_, *row);
+
+				return &output_row_;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+				inputs_.resize(rows.size());
+			}
+
+			auto const size{ this->input_.next_batch(std::span{ inputs_.data(), rows.size() }) };
+
+			for (std::size_t i{}; i < size; ++i)
+			{
+				fold<output_type, input_type>(buffer_[i], *inputs_[i]);
+				rows[i] = &buffer_[i];
+			}
+
+			return size;
+		}
+
+		// each input row is one output row, so skipping rows skips as many input rows
+		inline std::size_t skip(std::size_t count)
+		{
+			return this->input_.skip(count);
+		}
+
+	private:
+		template <typename Dest, typename Src>
+		static inline constexpr void fold(Dest& dest, Src const& src)
+		{
+			if constexpr (Dest::depth == 0)
+			{
+				return;
+			}
+			else
+			{
+				dest.head() = src.head();
+				fold<typename Dest::next, typename Src::next>(dest.tail(), src.tail());
+			}
+		}
+
+		output_type output_row_{};
+		std::vector<output_type> buffer_{};
+		std::vector<input_type const*> inputs_{};
+	};
+	
+} // namespace ra
+
+namespace ra
+{
+
+	// merge join of inputs which arrive sorted ascending on their join keys, only the right rows
+	//	sharing the key of the current left row are buffered
+	template <typename LeftInput, typename RightInput, cexpr::string LeftKey, cexpr::string RightKey,
+		typename Left = std::remove_cvref_t<typename LeftInput::output_type>,
+		typename Right = std::remove_cvref_t<typename RightInput::output_type>>
+	class sorted : public ra::join<LeftInput, RightInput, Left, Right>
+	{
+		using join_type = ra::join<LeftInput, RightInput, Left, Right>;
+		using left_type = typename join_type::left_type;
+		using right_type = typename join_type::right_type;
+		using key_type = std::remove_cvref_t<decltype(sql::get<LeftKey>(typename join_type::left_input_type{}))>;
+		using value_type = decltype(remainder<left_type, right_type>());
+
+		static_assert(sql::exists<LeftKey, left_type>(), "Left join key must be carried into the output row.");
+	public:
+		using output_type = join_type::output_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			join_type::seed(rs...);
+			restart();
+		}
+
+		void reset()
+		{
+			join_type::reset();
+			restart();
+		}
+
+		output_type const* next()
+		{
+			while (curr_ == end_)
+			{
+				if (!this->advance())
+				{
+					return nullptr;
+				}
+
+				match();
+			}
+
+			copy_after<left_type>(this->output_row_, *curr_++);
+
+			return &this->output_row_;
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			std::size_t size{};
+
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			while (size < rows.size())
+			{
+				if (curr_ == end_)
+				{
+					if (!this->advance())
+					{
+						break;
+					}
+
+					match();
+				}
+				else
+				{
+					buffer_[size] = this->output_row_;
+					copy_after<left_type>(buffer_[size], *curr_++);
+					rows[size] = &buffer_[size];
+					++size;
+				}
+			}
+
+			return size;
+		}
+
+	private:
+		// rewinds the right stream after its input was seeded or reset
+		inline void restart()
+		{
+			row_ = this->right_.next();
+			group_.clear();
+			match();
+		}
+
+		// points the cursor at the right rows with the key of the current left row, left rows sharing
+		//	a key reuse the group and right rows with smaller keys are skipped
+		void match()
+		{
+			if (!this->active_)
+			{
+				curr_ = end_;
+
+				return;
+			}
+
+			auto const& key{ sql::get<LeftKey>(this->output_row_) };
+
+			if (group_.empty() || key_ != key)
+			{
+				group_.clear();
+
+				while (row_ != nullptr && sql::get<RightKey>(*row_) < key)
+				{
+					row_ = this->right_.next();
+				}
+
+				while (row_ != nullptr && sql::get<RightKey>(*row_) == key)
+				{
+					fold<sql::void_row, value_type>(group_.emplace_back(), *row_);
+					row_ = this->right_.next();
+				}
+
+				key_ = key;
+			}
+
+			curr_ = group_.data();
+			end_ = group_.data() + group_.size();
+		}
+
+		typename join_type::right_input_type const* row_{};
+		std::vector<value_type> group_{};
+		key_type key_{};
+		std::vector<output_type> buffer_{};
+		value_type const* curr_{};
+		value_type const* end_{};
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	// sort based aggregation of an input which arrives ordered on its one Keys column, the rows of a group
+	//	are adjacent so each group is output as soon as a row of the next key is read, and only the state
+	//	of the current group is kept
+	template <typename Output, typename Keys, typename Aggregates, typename Input>
+	class streamed : public ra::aggregation<Output, Keys, Aggregates, Input>
+	{
+		using base_type = ra::aggregation<Output, Keys, Aggregates, Input>;
+		using input_type = typename base_type::input_type;
+		using key_type = typename base_type::key_type;
+		using state_type = typename base_type::state_type;
+
+		static_assert(Keys::depth == 1, "Streamed aggregation groups on a single ordered column.");
+
+		static constexpr std::size_t batch_size{ 1024 };
+	public:
+		using output_type = Output;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			this->input_.seed(rs...);
+			restart();
+		}
+
+		void reset()
+		{
+			this->input_.reset();
+			restart();
+		}
+
+		// groups are output in ascending order of their keys
+		output_type const* next()
+		{
+			return advance(output_row_) ? &output_row_ : nullptr;
+		}
+
+		// output rows are buffered by the node and stay valid until its next call
+		std::size_t next_batch(std::span<output_type const*> rows)
+		{
+			if (buffer_.size() < rows.size())
+			{
+				buffer_.resize(rows.size());
+			}
+
+			std::size_t size{};
+
+			for (; size < rows.size() && advance(buffer_[size]); ++size)
+			{
+				rows[size] = &buffer_[size];
+			}
+
+			return size;
+		}
+
+	private:
+		inline void restart()
+		{
+			rows_.resize(batch_size);
+			curr_ = 0;
+			count_ = 0;
+			open_ = false;
+			done_ = false;
+		}
+
+		// next input row, read from the input a batch at a time
+		inline input_type const* pull()
+		{
+			if (curr_ == count_)
+			{
+				count_ = done_ ? 0 : this->input_.next_batch(std::span{ rows_ });
+				curr_ = 0;
+				done_ = count_ == 0;
+
+				if (done_)
+				{
+					return nullptr;
+				}
+			}
+
+			return rows_[curr_++];
+		}
+
+		// folds input rows into the current group until a row of another key closes it, the closed group is output to dest
+		bool advance(output_type& dest)
+		{
+			for (auto row{ pull() }; row != nullptr; row = pull())
+			{
+				if (!open_)
+				{
+					key_ = base_type::key(*row);
+					base_type::init(state_, *row);
+					open_ = true;
+				}
+				else if (base_type::key(*row) == key_)
+				{
+					base_type::update(state_, *row);
+				}
+				else
+				{
+					base_type::emit(dest, state_);
+					key_ = base_type::key(*row);
+					base_type::init(state_, *row);
+
+					return true;
+				}
+			}
+
+			if (open_)
+			{
+				base_type::emit(dest, state_);
+				open_ = false;
+
+				return true;
+			}
+
+			return false;
+		}
+
+		std::vector<input_type const*> rows_{};
+		std::size_t curr_{};
+		std::size_t count_{};
+		bool open_{};
+		bool done_{};
+		key_type key_{};
+		state_type state_{};
+		output_type output_row_{};
+		std::vector<output_type> buffer_{};
+	};
+
+} // namespace ra
+
+namespace ra
+{
+
+	// row count of a query without a LIMIT clause
+	inline constexpr std::size_t unlimited{ std::numeric_limits<std::size_t>::max() };
+
+	// first Limit input rows in the order of the sql::order Order, the input is drained in one pass when the
+	//	node is seeded into a heap holding at most Limit rows, whose root is the last row kept so far and is
+	//	replaced by every row which sorts before it, without a Limit every row is kept and sorted
+	template <typename Order, std::size_t Limit, typename Input>
+	class top : public ra::unary<Input>
+	{
+		using input_type = typename ra::unary<Input>::input_type;
+		using comparator = typename Order::template comparator<input_type>;
+
+		static constexpr std::size_t batch_size{ 1024 };
+	public:
+		using output_type = input_type;
+
+		template <typename... Inputs>
+		void seed(Inputs const&... rs)
+		{
+			this->input_.seed(rs...);
+			rows_.clear();
+			curr_ = 0;
+
+			if constexpr (Limit != 0)
+			{
+				std::vector<input_type const*> rows(batch_size);
+
+				for (auto count{ this->input_.next_batch(std::span{ rows }) }; count != 0; count = this->input_.next_batch(std::span{ rows }))
+				{
+					for (std::size_t i{}; i < count; ++i)
+					{
+						keep(*rows[i]);
+					}
+				}
+
+				if constexpr (Limit == ra::unlimited)
+				{
+					std::sort(rows_.begin(), rows_.end(), comparator{});
+				}
+				else
+				{
+					std::sort_heap(rows_.begin(), rows_.end(), comparator{});
+				}
+			}
+		}
+
+		// replays the sorted rows, the input is only drained again when the node is seeded
+		inline void reset() noexcept
+		{
+			curr_ = 0;
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return rows_.size();
+		}
+
+		output_type const* next() noexcept
+		{
+			return curr_ < rows_.size() ? &rows_[curr_++] : nullptr;
+		}
+
+		// output rows are held by the node and stay valid until it is seeded again
+		std::size_t next_batch(std::span<output_type const*> rows) noexcept
+		{
+			std::size_t size{};
+
+			for (; size < rows.size() && curr_ < rows_.size(); ++size, ++curr_)
+			{
+				rows[size] = &rows_[curr_];
+			}
+
+			return size;
+		}
+
+		// advances past up to count sorted rows, returns the number of rows skipped
+		inline std::size_t skip(std::size_t count) noexcept
+		{
+			auto const size{ std::min(count, rows_.size() - curr_) };
+			curr_ += size;
+
+			return size;
+		}
+
+	private:
+		inline void keep(input_type const& row)
+		{
+			if constexpr (Limit == ra::unlimited)
+			{
+				rows_.push_back(row);
+			}
+			else if (rows_.size() < Limit)
+			{
+				rows_.push_back(row);
+				std::push_heap(rows_.begin(), rows_.end(), comparator{});
+			}
+			else if (comparator{}(row, rows_.front()))
+			{
+				std::pop_heap(rows_.begin(), rows_.end(), comparator{});
+				rows_.back() = row;
+				std::push_heap(rows_.begin(), rows_.end(), comparator{});
+			}
+		}
+
+		std::vector<input_type> rows_{};
+		std::size_t curr_{};
+	};
+
+} // namespace ra
+
+namespace sql
+{
+
+	namespace
+	{
+
+		// value held by a column of type Type, the type inside std::optional for nullable columns
+		template <typename Type>
+		using held = typename nullable_type<Type>::type::value_type;
+
+		// type sums of Type accumulate in, integers widen to 64 bits and floating point types to double
+		template <typename Type>
+		using accumulator = std::conditional_t<std::is_floating_point_v<Type>, double,
+			std::conditional_t<std::is_signed_v<Type>, std::int64_t, std::uint64_t>>;
+
+		// aggregates whose groups may hold no value output std::optional columns which are null for them
+		template <typename Type, bool Nullable>
+		constexpr auto finish(std::optional<Type> const& acc)
+		{
+			if constexpr (Nullable)
+			{
+				return acc;
+			}
+			else
+			{
+				return *acc;
+			}
+		}
+
+	} // namespace
+
+	// aggregate nodes compute one output column of a query with GROUP BY or aggregates, init starts the state of a group
+	//	from its first row, update folds every later row of the group into it, and result reads the column,
+	//	a default constructed state is the state of a group without rows
+
+	// GROUP BY column, every row of a group holds the same value
+	template <cexpr::string Column, typename Type>
+	struct grouped
+	{
+		using state = Type;
+		using type = Type;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row)
+		{
+			acc = sql::get<Column>(row);
+		}
+
+		template <typename Row>
+		static inline void update([[maybe_unused]] state& acc, [[maybe_unused]] Row const& row) noexcept
+		{}
+
+		static inline type const& result(state const& acc) noexcept
+		{
+			return acc;
+		}
+	};
+
+	// COUNT(*) counts the rows of a group, COUNT(Column) the rows whose Column is not null
+	template <cexpr::string Column>
+	struct count
+	{
+		using state = std::size_t;
+		using type = std::size_t;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row) noexcept
+		{
+			acc = counted(row) ? 1 : 0;
+		}
+
+		template <typename Row>
+		static inline void update(state& acc, Row const& row) noexcept
+		{
+			acc += counted(row) ? 1 : 0;
+		}
+
+		static inline type result(state const& acc) noexcept
+		{
+			return acc;
+		}
+
+	private:
+		template <typename Row>
+		static inline bool counted([[maybe_unused]] Row const& row) noexcept
+		{
+			if constexpr (Column == "*")
+			{
+				return true;
+			}
+			else
+			{
+				return known(sql::get<Column>(row));
+			}
+		}
+	};
+
+	// SUM(Column) of the non null values of the Type column, Nullable when a group may hold none of them
+	template <cexpr::string Column, typename Type, bool Nullable>
+	struct sum
+	{
+		static_assert(std::is_arithmetic_v<held<Type>>, "SUM requires a numeric column.");
+
+		using state = std::optional<accumulator<held<Type>>>;
+		using type = std::conditional_t<Nullable, state, typename state::value_type>;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row) noexcept
+		{
+			acc.reset();
+			update(acc, row);
+		}
+
+		template <typename Row>
+		static inline void update(state& acc, Row const& row) noexcept
+		{
+			auto const& val{ sql::get<Column>(row) };
+
+			if (known(val))
+			{
+				acc = acc.value_or(0) + unwrap(val);
+			}
+		}
+
+		static inline type result(state const& acc) noexcept
+		{
+			return finish<typename state::value_type, Nullable>(acc);
+		}
+	};
+
+	// AVG(Column), the mean of the non null values of the Type column as a double
+	template <cexpr::string Column, typename Type, bool Nullable>
+	struct avg
+	{
+		static_assert(std::is_arithmetic_v<held<Type>>, "AVG requires a numeric column.");
+
+		struct state
+		{
+			double sum;
+			std::size_t count;
+		};
+
+		using type = std::conditional_t<Nullable, std::optional<double>, double>;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row) noexcept
+		{
+			acc = state{};
+			update(acc, row);
+		}
+
+		template <typename Row>
+		static inline void update(state& acc, Row const& row) noexcept
+		{
+			auto const& val{ sql::get<Column>(row) };
+
+			if (known(val))
+			{
+				acc.sum += unwrap(val);
+				++acc.count;
+			}
+		}
+
+		static inline type result(state const& acc) noexcept
+		{
+			return finish<double, Nullable>(acc.count == 0 ? std::optional<double>{} : acc.sum / acc.count);
+		}
+	};
+
+	// MIN(Column) when Less is true, otherwise MAX(Column), of the non null values of the Type column
+	template <cexpr::string Column, typename Type, bool Nullable, bool Less>
+	struct extreme
+	{
+		using state = std::optional<held<Type>>;
+		using type = std::conditional_t<Nullable, state, typename state::value_type>;
+
+		template <typename Row>
+		static inline void init(state& acc, Row const& row)
+		{
+			acc.reset();
+			update(acc, row);
+		}
+
+		template <typename Row>
+		static inline void update(state& acc, Row const& row)
+		{
+			auto const& val{ sql::get<Column>(row) };
+
+			if (known(val) && (!acc || (Less ? unwrap(val) < *acc : *acc < unwrap(val))))
+			{
+				acc = unwrap(val);
+			}
+		}
+
+		static inline type result(state const& acc)
+		{
+			return finish<typename state::value_type, Nullable>(acc);
+		}
+	};
+
+	template <cexpr::string Column, typename Type, bool Nullable>
+	using min = extreme<Column, Type, Nullable, true>;
+
+	template <cexpr::string Column, typename Type, bool Nullable>
+	using max = extreme<Column, Type, Nullable, false>;
+
+} // namespace sql
+
+namespace sql
+{
+
+	// column of an ORDER BY clause, descending columns order their largest values first
+	template <cexpr::string Name, bool Descending>
+	struct direction
+	{
+		static constexpr auto name{ Name };
+		static constexpr bool descending{ Descending };
+	};
+
+	// ORDER BY clause over the sql::direction Columns, earlier columns take precedence
+	template <typename... Columns>
+	struct order
+	{
+		template <typename Row>
+		struct comparator
+		{
+			bool operator()(Row const& left, Row const& right) const noexcept
+			{
+				return compare<Columns...>(left, right);
+			}
+
+		private:
+			template <typename Col, typename... Cols>
+			bool compare(Row const& left, Row const& right) const noexcept
+			{
+				auto const& l{ sql::get<Col::name>(left) };
+				auto const& r{ sql::get<Col::name>(right) };
+
+				if constexpr (sizeof...(Cols) != 0)
+				{
+					if (l == r)
+					{
+						return compare<Cols...>(left, right);
+					}
+				}
+
+				if constexpr (Col::descending)
+				{
+					return r < l;
+				}
+				else
+				{
+					return l < r;
+				}
+			}
+		};
+	};
+
+} // namespace sql
+
+namespace sql
+{
+	namespace
+	{
+		
+		template <typename Char>
+		constexpr bool whitespace(Char curr)
+		{
+			return curr == Char{ ' ' } || curr == Char{ '\t' } || curr == Char{ '\n' };
+		}
+
+		template <typename Char>
+		constexpr bool syntax(Char curr)
+		{
+			return curr == Char{ ',' } || curr == Char{ '(' } || curr == Char{ ')' } ||
+				curr == Char{ '\'' } || curr == Char{ '\"' } || curr == Char{ '=' };
+		}
+
+		template <typename Char>
+		constexpr const Char* skip(const Char *curr, const Char *end)
+		{
+			for (; curr != end && whitespace(*curr); ++curr);
+			return curr;
+		}
+
+		template <typename Char>
+		constexpr const Char* next(const Char *curr, const Char *end)
+		{
+			Char c{ *curr };
+
+			if (c == Char{ '>' } || c == Char{ '<' } || c == Char{ '!' })
+			{
+				++curr;
+
+				if (*curr == Char{ '=' } || (c == Char{ '<' } && *curr == Char{ '>' }))
+				{
+					++curr;
+				}
+			}
+			else if (syntax(c))
+			{
+				++curr;
+			}
+			else
+			{
+				for (; curr != end && !whitespace(*curr) && !syntax(*curr); ++curr);
+			}
+			
+			return curr;
+		}
+	
+	} // namespace
+
+	template <typename Char, std::size_t Count>
+	class tokens
+	{
+	public:
+		using token_view = std::basic_string_view<Char>;
+
+		constexpr tokens() = default;
+
+		template<std::size_t N>
+		constexpr tokens(cexpr::string<Char, N> const& cs) : tokens_{}
+		{
+			auto curr{ cs.cbegin() }, last{ cs.cbegin() };
+			const auto end{ cs.cend() };
+			std::size_t i{};
+
+			while (curr < end)
+			{
+				curr = skip(curr, end);
+				last = curr;
+				last = next(last, end);
+
+				if (*curr == Char{ '\"' } || *curr == Char{ '\'' })
+				{
+					tokens_[i++] = token_view{ curr, 1 };
+					for (char c{ *curr++ }; last != end && *last != c; ++last);
+				}
+
+				auto len{ reinterpret_cast<std::size_t>(last) - reinterpret_cast<std::size_t>(curr) };
+				tokens_[i++] = token_view{ curr, len };
+
+				if (*last == Char{ '\"' } || *last == Char{ '\'' })
+				{
+					tokens_[i++] = token_view{ last, 1 };
+					++last;
+				}
+
+				curr = last;
+			}
+		}
+
+		constexpr std::size_t count() const noexcept
+		{
+			return Count;
+		}
+
+		constexpr token_view* begin() noexcept
+		{
+			return tokens_.begin();
+		}
+		constexpr const token_view* cbegin() const noexcept
+		{
+			return tokens_.cbegin();
+		}
+
+		constexpr token_view* end() noexcept
+		{
+			return tokens_.end();
+		}
+		constexpr const token_view* cend() const noexcept
+		{
+			return tokens_.cend();
+		}
+
+		constexpr token_view& operator[](std::size_t i)
+		{
+			return tokens_[i];
+		}
+		constexpr token_view const& operator[](std::size_t i) const
+		{
+			return tokens_[i];
+		}
+
+	private:
+		std::array<token_view, Count> tokens_;
+	};
+
+	template<typename Char, std::size_t N>
+	constexpr std::size_t preprocess(cexpr::string<Char, N> const& cs) noexcept
+	{
+		auto begin{ cs.cbegin() };
+		const auto end{ cs.cend() };
+		std::size_t count{ 1 };
+
+		while (begin < end)
+		{
+			begin = skip(begin, end);
+			begin = next(begin, end);
+			++count;
+		}
+
+		return count;
+	}
+
+} // namespace sql
+
+namespace sql
+{
+
+	// anonymous namespace to hold helper data structures and functions
+	namespace
+	{
+
+		template <std::size_t Pos, typename Node>
+		struct context
+		{
+			using node = Node;
+			static constexpr std::size_t pos = Pos;
+		};
+
+		template <typename Type, std::size_t Name, std::size_t Next>
+		struct colinfo
+		{
+			using type = Type;
+			static constexpr std::size_t name = Name;
+			static constexpr std::size_t next = Next;
+		};
+
+		// output row of the select list of a grouped query and the aggregates computing each of its columns
+		template <typename Output, typename Aggregates>
+		struct selects
+		{
+			using output = Output;
+			using aggregates = Aggregates;
+		};
+
+		// prepends the Col direction to an ORDER BY clause
+		template <typename Col, typename... Cols>
+		constexpr auto prepend(sql::order<Cols...>) noexcept
+		{
+			return sql::order<Col, Cols...>{};
+		}
+
+		// LIMIT clause ending before Pos, Count rows are output after skipping Offset rows
+		template <std::size_t Pos, std::size_t Count, std::size_t Offset>
+		struct bounds
+		{
+			static constexpr std::size_t pos{ Pos };
+			static constexpr std::size_t count{ Count };
+			static constexpr std::size_t offset{ Offset };
+		};
+
+		// expression trees which only scan, filter, and transform a single relation
+		template <typename Node>
+		struct scan : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct scan<ra::relation<Schema, Id, Columns>> : std::true_type
+		{
+			using schema = Schema;
+		};
+
+		template <typename Predicate, typename Input>
+		struct scan<ra::selection<Predicate, Input>> : scan<Input>
+		{};
+
+		template <typename Output, typename Input>
+		struct scan<ra::projection<Output, Input>> : scan<Input>
+		{};
+
+		template <typename Output, typename Input>
+		struct scan<ra::rename<Output, Input>> : scan<Input>
+		{};
+
+		// expression trees which can narrow their scan to the rows of one key through a schema index
+		template <typename Node>
+		struct seekable : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct seekable<ra::relation<Schema, Id, Columns>> : std::true_type
+		{};
+
+		template <typename Predicate, typename Input>
+		struct seekable<ra::selection<Predicate, Input>> : seekable<Input>
+		{};
+
+		// expression trees outputting one row per row of a scan or of sorted rows, which pass over rows without reading them
+		template <typename Node>
+		struct skippable : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns>
+		struct skippable<ra::relation<Schema, Id, Columns>> : std::true_type
+		{};
+
+		template <typename Output, typename Input>
+		struct skippable<ra::projection<Output, Input>> : skippable<Input>
+		{};
+
+		template <typename Output, typename Input>
+		struct skippable<ra::rename<Output, Input>> : skippable<Input>
+		{};
+
+		template <typename Order, std::size_t Limit, typename Input>
+		struct skippable<ra::top<Order, Limit, Input>> : std::true_type
+		{};
+
+		// true when the column of the renamed Output row named Name holds the Input column of the same name
+		template <cexpr::string Name, typename Output, typename Input>
+		constexpr bool unrenamed() noexcept
+		{
+			if constexpr (Output::depth == 0)
+			{
+				return false;
+			}
+			else if constexpr (Output::column::name == Name)
+			{
+				return Input::column::name == Name;
+			}
+			else
+			{
+				return unrenamed<Name, typename Output::next, typename Input::next>();
+			}
+		}
+
+		// expression trees streaming their rows in ascending order of the Name column, which is only carried
+		//	through a rename by a column keeping the name of the column it holds
+		template <typename Node, cexpr::string Name>
+		struct sorted_on : std::false_type
+		{};
+
+		template <typename Schema, std::size_t Id, typename Columns, cexpr::string Name>
+		struct sorted_on<ra::relation<Schema, Id, Columns>, Name> : std::bool_constant<Schema::template ordered<Name>()>
+		{};
+
+		template <typename Predicate, typename Input, cexpr::string Name>
+		struct sorted_on<ra::selection<Predicate, Input>, Name> : sorted_on<Input, Name>
+		{};
+
+		template <typename Output, typename Input, cexpr::string Name>
+		struct sorted_on<ra::projection<Output, Input>, Name> : sorted_on<Input, Name>
+		{};
+
+		template <typename Output, typename Input, cexpr::string Name>
+		struct sorted_on<ra::rename<Output, Input>, Name>
+			: std::bool_constant<unrenamed<Name, Output, std::remove_cvref_t<typename Input::output_type>>() && sorted_on<Input, Name>::value>
+		{};
+
+		// true when Node streams its rows in ascending order of the Name column
+		template <typename Node, cexpr::string Name>
+		constexpr bool ordered() noexcept
+		{
+			return sorted_on<Node, Name>::value;
+		}
+
+		// true when Node outputs the rows sharing a value of the one Keys column together
+		template <typename Node, typename Keys>
+		constexpr bool streamable() noexcept
+		{
+			if constexpr (Keys::depth == 1)
+			{
+				return ordered<Node, Keys::column::name>();
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		// Row less the column named Name
+		template <cexpr::string Name, typename Row>
+		constexpr auto without()
+		{
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return sql::void_row{};
+			}
+			else if constexpr (Row::column::name == Name)
+			{
+				return typename Row::next{};
+			}
+			else
+			{
+				using next = decltype(without<Name, typename Row::next>());
+
+				return sql::row<typename Row::column, next>{};
+			}
+		}
+
+		// left columns which hide right columns of the same name, a key named alike on both sides holds equal values
+		template <typename LeftCols, cexpr::string LeftKey, cexpr::string RightKey>
+		constexpr auto hidden()
+		{
+			if constexpr (LeftKey == RightKey)
+			{
+				return without<LeftKey, LeftCols>();
+			}
+			else
+			{
+				return LeftCols{};
+			}
+		}
+
+		// expected rows of a join chain relation, zero unless it scans a schema with a cardinality hint
+		template <typename Node>
+		constexpr std::size_t estimate() noexcept
+		{
+			if constexpr (scan<Node>::value)
+			{
+				return sql::cardinality<typename scan<Node>::schema>;
+			}
+			else
+			{
+				return 0;
+			}
+		}
+
+		// inner equi join nodes, the joins of a chain which may be reordered
+		template <typename Node>
+		struct equi : std::false_type
+		{};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols, ra::side Build>
+		struct equi<ra::inner<Left, Right, LeftKey, RightKey, LeftCols, RightCols, Build>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+
+			static constexpr auto left_key{ LeftKey };
+			static constexpr auto right_key{ RightKey };
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		struct equi<ra::sorted<Left, Right, LeftKey, RightKey, LeftCols, RightCols>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+
+			static constexpr auto left_key{ LeftKey };
+			static constexpr auto right_key{ RightKey };
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		struct equi<ra::indexed<Left, Right, LeftKey, RightKey, LeftCols, RightCols>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+
+			static constexpr auto left_key{ LeftKey };
+			static constexpr auto right_key{ RightKey };
+		};
+
+		// ON clause equating the LeftKey column of the relation at LeftId of a join chain with the RightKey column of the one at RightId
+		template <std::size_t LeftId, cexpr::string LeftKey, std::size_t RightId, cexpr::string RightKey>
+		struct link
+		{
+			static constexpr std::size_t left_id{ LeftId };
+			static constexpr auto left_key{ LeftKey };
+			static constexpr std::size_t right_id{ RightId };
+			static constexpr auto right_key{ RightKey };
+		};
+
+		// order a chain joins its relations in, and the link joining each relation to the ones before it
+		template <std::size_t Size>
+		struct plan
+		{
+			std::array<std::size_t, Size> ids{};
+			std::array<std::size_t, Size> links{};
+		};
+
+		// relations of a left deep chain of inner equi joins in written order, and the links between them
+		template <typename Relations, typename Links>
+		struct chain;
+
+		template <typename... Relations, typename... Links>
+		struct chain<std::tuple<Relations...>, std::tuple<Links...>>
+		{
+			using relations = std::tuple<Relations...>;
+			using links = std::tuple<Links...>;
+
+			template <std::size_t Id, cexpr::string Name>
+			using column_type = std::remove_cvref_t<decltype(sql::get<Name>(std::remove_cvref_t<typename std::tuple_element_t<Id, relations>::output_type>{}))>;
+
+			static constexpr std::size_t size{ sizeof...(Relations) };
+
+			// every relation scans a schema with a cardinality hint
+			static constexpr bool hinted{ ((estimate<Relations>() != 0) && ...) };
+
+			// links naming the same column on both sides, whose columns merge into one
+			static constexpr std::size_t equated{ ((Links::left_key == Links::right_key ? 1 : 0) + ... + 0) };
+
+			// columns merged by a link hold the same type
+			static constexpr bool typed{ ((Links::left_key != Links::right_key || std::is_same_v<column_type<Links::left_id, Links::left_key>, column_type<Links::right_id, Links::right_key>>) && ...) };
+
+			// starts from the smallest relation, then joins the smallest relation linked to the ones joined so far,
+			//	ties keep the written order
+			static constexpr plan<size> order() noexcept
+			{
+				std::array<std::size_t, size> const rows{ estimate<Relations>()... };
+				std::array<std::size_t, size - 1> const lefts{ Links::left_id... };
+				std::array<std::size_t, size - 1> const rights{ Links::right_id... };
+				std::array<bool, size> joined{};
+				plan<size> result{};
+
+				for (std::size_t step{}; step < size; ++step)
+				{
+					std::size_t best{ size };
+
+					for (std::size_t id{}; id < size; ++id)
+					{
+						if (joined[id] || (best != size && rows[best] <= rows[id]))
+						{
+							continue;
+						}
+
+						for (std::size_t l{}; l < size - 1 && best != id; ++l)
+						{
+							if (step == 0 || (lefts[l] == id && joined[rights[l]]) || (rights[l] == id && joined[lefts[l]]))
+							{
+								best = id;
+								result.links[step] = l;
+							}
+						}
+					}
+
+					result.ids[step] = best;
+					joined[best] = true;
+				}
+
+				return result;
+			}
+
+			// the planned order differs from the written one
+			static constexpr bool reordered() noexcept
+			{
+				auto const result{ order() };
+
+				for (std::size_t id{}; id < size; ++id)
+				{
+					if (result.ids[id] != id)
+					{
+						return true;
+					}
+				}
+
+				return false;
+			}
+		};
+
+		// position of the first relation of Relations whose rows carry the Name column, the one a join's merged row takes it from
+		template <cexpr::string Name, typename Relations, std::size_t Id = 0>
+		constexpr std::size_t owner() noexcept
+		{
+			static_assert(Id < std::tuple_size_v<Relations>, "Join key was not carried by any joined relation.");
+
+			if constexpr (sql::exists<Name, std::remove_cvref_t<typename std::tuple_element_t<Id, Relations>::output_type>>())
+			{
+				return Id;
+			}
+			else
+			{
+				return owner<Name, Relations, Id + 1>();
+			}
+		}
+
+		// Tuple with Type appended
+		template <typename Tuple, typename Type>
+		struct append;
+
+		template <typename... Types, typename Type>
+		struct append<std::tuple<Types...>, Type>
+		{
+			using type = std::tuple<Types..., Type>;
+		};
+
+		// chain of the inner equi joins along the left edge of Node, other nodes are a chain of one relation
+		template <typename Node>
+		constexpr auto flatten()
+		{
+			if constexpr (equi<Node>::value)
+			{
+				using join = equi<Node>;
+				using prefix = decltype(flatten<typename join::left>());
+				using relations = typename prefix::relations;
+				using next = link<owner<join::left_key, relations>(), join::left_key, std::tuple_size_v<relations>, join::right_key>;
+
+				return chain<typename append<relations, typename join::right>::type, typename append<typename prefix::links, next>::type>{};
+			}
+			else
+			{
+				return chain<std::tuple<Node>, std::tuple<>>{};
+			}
+		}
+
+		// exposes the operands of AND predicate nodes
+		template <typename Node>
+		struct conjunction : std::false_type
+		{};
+
+		template <typename Row, typename Left, typename Right>
+		struct conjunction<sql::operation<"AND", Row, Left, Right>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+		};
+
+		// exposes the columns of predicate nodes comparing two columns for equality
+		template <typename Node>
+		struct equality : std::false_type
+		{};
+
+		template <typename Row, cexpr::string LeftColumn, cexpr::string RightColumn>
+		struct equality<sql::operation<"=", Row, sql::variable<LeftColumn, Row>, sql::variable<RightColumn, Row>>> : std::true_type
+		{
+			static constexpr auto left{ LeftColumn };
+			static constexpr auto right{ RightColumn };
+		};
+
+		// equality conjunct Conjunct oriented so LeftKey is a column of the left input and RightKey one of the right input
+		template <cexpr::string LeftKey, cexpr::string RightKey, typename Conjunct>
+		struct keyed
+		{
+			static constexpr auto left_key{ LeftKey };
+			static constexpr auto right_key{ RightKey };
+
+			using conjunct = Conjunct;
+		};
+
+		// cross join nodes, which an equality of a column of each input turns into an equi join
+		template <typename Node>
+		struct product : std::false_type
+		{};
+
+		template <typename Left, typename Right, typename LeftCols, typename RightCols, std::size_t Block>
+		struct product<ra::cross<Left, Right, LeftCols, RightCols, Block>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using left_columns = LeftCols;
+			using right_columns = RightCols;
+		};
+
+		// exposes the inputs of join nodes, shadow holds the left columns which hide right columns of the same name
+		template <typename Node>
+		struct join_inputs : std::false_type
+		{};
+
+		template <typename Left, typename Right, typename LeftCols, typename RightCols, ra::side Build>
+		struct join_inputs<ra::natural<Left, Right, LeftCols, RightCols, Build>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = typename LeftCols::next;
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::natural<NewLeft, NewRight, LeftCols, RightCols, Build>;
+		};
+
+		template <typename Left, typename Right, typename LeftCols, typename RightCols, std::size_t Block>
+		struct join_inputs<ra::cross<Left, Right, LeftCols, RightCols, Block>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = LeftCols;
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::cross<NewLeft, NewRight, LeftCols, RightCols, Block>;
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols, ra::side Build>
+		struct join_inputs<ra::inner<Left, Right, LeftKey, RightKey, LeftCols, RightCols, Build>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = decltype(hidden<LeftCols, LeftKey, RightKey>());
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::inner<NewLeft, NewRight, LeftKey, RightKey, LeftCols, RightCols, Build>;
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols, ra::keep Keep>
+		struct join_inputs<ra::outer<Left, Right, LeftKey, RightKey, LeftCols, RightCols, Keep>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = LeftCols;
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::outer<NewLeft, NewRight, LeftKey, RightKey, LeftCols, RightCols, Keep>;
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		struct join_inputs<ra::indexed<Left, Right, LeftKey, RightKey, LeftCols, RightCols>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = decltype(hidden<LeftCols, LeftKey, RightKey>());
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::indexed<NewLeft, NewRight, LeftKey, RightKey, LeftCols, RightCols>;
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		struct join_inputs<ra::sorted<Left, Right, LeftKey, RightKey, LeftCols, RightCols>> : std::true_type
+		{
+			using left = Left;
+			using right = Right;
+			using shadow = decltype(hidden<LeftCols, LeftKey, RightKey>());
+
+			template <typename NewLeft, typename NewRight>
+			using rebuild = ra::sorted<NewLeft, NewRight, LeftKey, RightKey, LeftCols, RightCols>;
+		};
+
+		// inputs of join nodes padded with nulls, filtering them before the join would pad the rows it removes
+		template <typename Node>
+		struct padding
+		{
+			static constexpr bool left{ false };
+			static constexpr bool right{ false };
+		};
+
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols, ra::keep Keep>
+		struct padding<ra::outer<Left, Right, LeftKey, RightKey, LeftCols, RightCols, Keep>>
+		{
+			static constexpr bool left{ Keep != ra::keep::left };
+			static constexpr bool right{ Keep != ra::keep::right };
+		};
+
+		// column type held by view rows, strings refer into the schema storage and other types are copied
+		template <typename Type>
+		constexpr auto view_type()
+		{
+			if constexpr (std::is_same_v<Type, std::string>)
+			{
+				return std::string_view{};
+			}
+			else
+			{
+				return Type{};
+			}
+		}
+
+		template <typename Type, typename Char, std::size_t N>
+		constexpr value<Type> convert(cexpr::string<Char, N> const& str) noexcept
+		{
+			auto curr{ str.cbegin() }, end{ str.cend() };
+			constexpr Char dot{ '.' }, zro{ '0' }, min{ '-' };
+			Type acc{}, sign{ 1 }, scalar{ 10 };
+
+			if (*curr == min)
+			{
+				sign = -1;
+				++curr;
+			}
+
+			while (curr != end && *curr != dot)
+			{
+				acc = (acc * scalar) + (*curr - zro);
+				++curr;
+			}
+
+			if (curr != end && *curr == dot)
+			{
+				scalar = 1;
+				++curr;
+
+				while(curr != end)
+				{
+					acc += (*curr - zro) * (scalar /= Type{ 10 });
+					++curr;
+				}
+			}
+
+			return value<Type>{ acc * sign };
+		}
+
+		inline constexpr bool isquote(std::string_view const& tv) noexcept
+		{
+			return tv == "\"" || tv == "'";
+		}
+
+		inline constexpr bool isor(std::string_view const& tv) noexcept
+		{
+			return tv == "OR" || tv == "or";
+		}
+
+		inline constexpr bool isand(std::string_view const& tv) noexcept
+		{
+			return tv == "AND" || tv == "and";
+		}
+
+		inline constexpr bool isnot(std::string_view const& tv) noexcept
+		{
+			return tv == "NOT" || tv == "not";
+		}
+
+		inline constexpr bool isnatural(std::string_view const& tv) noexcept
+		{
+			return tv == "NATURAL" || tv == "natural";
+		}
+
+		inline constexpr bool isjoin(std::string_view const& tv) noexcept
+		{
+			return tv == "JOIN" || tv == "join";
+		}
+
+		inline constexpr bool isinner(std::string_view const& tv) noexcept
+		{
+			return tv == "INNER" || tv == "inner";
+		}
+
+		inline constexpr bool isleft(std::string_view const& tv) noexcept
+		{
+			return tv == "LEFT" || tv == "left";
+		}
+
+		inline constexpr bool isright(std::string_view const& tv) noexcept
+		{
+			return tv == "RIGHT" || tv == "right";
+		}
+
+		inline constexpr bool isfull(std::string_view const& tv) noexcept
+		{
+			return tv == "FULL" || tv == "full";
+		}
+
+		inline constexpr bool isouter(std::string_view const& tv) noexcept
+		{
+			return tv == "OUTER" || tv == "outer";
+		}
+
+		// join types which are followed by an ON clause
+		inline constexpr bool isequi(std::string_view const& tv) noexcept
+		{
+			return isinner(tv) || isleft(tv) || isright(tv) || isfull(tv);
+		}
+
+		inline constexpr bool ison(std::string_view const& tv) noexcept
+		{
+			return tv == "ON" || tv == "on";
+		}
+
+		inline constexpr bool iswhere(std::string_view const& tv) noexcept
+		{
+			return tv == "WHERE" || tv == "where";
+		}
+
+		inline constexpr bool isfrom(std::string_view const& tv) noexcept
+		{
+			return tv == "FROM" || tv == "from";
+		}
+
+		inline constexpr bool isas(std::string_view const& tv) noexcept
+		{
+			return tv == "AS" || tv == "as";
+		}
+
+		inline constexpr bool isgroup(std::string_view const& tv) noexcept
+		{
+			return tv == "GROUP" || tv == "group";
+		}
+
+		inline constexpr bool isby(std::string_view const& tv) noexcept
+		{
+			return tv == "BY" || tv == "by";
+		}
+
+		inline constexpr bool isorder(std::string_view const& tv) noexcept
+		{
+			return tv == "ORDER" || tv == "order";
+		}
+
+		inline constexpr bool isasc(std::string_view const& tv) noexcept
+		{
+			return tv == "ASC" || tv == "asc";
+		}
+
+		inline constexpr bool isdesc(std::string_view const& tv) noexcept
+		{
+			return tv == "DESC" || tv == "desc";
+		}
+
+		inline constexpr bool islimit(std::string_view const& tv) noexcept
+		{
+			return tv == "LIMIT" || tv == "limit";
+		}
+
+		inline constexpr bool isoffset(std::string_view const& tv) noexcept
+		{
+			return tv == "OFFSET" || tv == "offset";
+		}
+
+		inline constexpr bool iscount(std::string_view const& tv) noexcept
+		{
+			return tv == "COUNT" || tv == "count";
+		}
+
+		inline constexpr bool issum(std::string_view const& tv) noexcept
+		{
+			return tv == "SUM" || tv == "sum";
+		}
+
+		inline constexpr bool isavg(std::string_view const& tv) noexcept
+		{
+			return tv == "AVG" || tv == "avg";
+		}
+
+		inline constexpr bool ismin(std::string_view const& tv) noexcept
+		{
+			return tv == "MIN" || tv == "min";
+		}
+
+		inline constexpr bool ismax(std::string_view const& tv) noexcept
+		{
+			return tv == "MAX" || tv == "max";
+		}
+
+		inline constexpr bool isaggregate(std::string_view const& tv) noexcept
+		{
+			return iscount(tv) || issum(tv) || isavg(tv) || ismin(tv) || ismax(tv);
+		}
+
+		inline constexpr bool isselect(std::string_view const& tv) noexcept
+		{
+			return tv == "SELECT" || tv == "select";
+		}
+
+		inline constexpr bool iscomma(std::string_view const& tv) noexcept
+		{
+			return tv == ",";
+		}
+
+		// column name of a possibly schema qualified column token ("books.title" names "title")
+		constexpr std::string_view unqualified(std::string_view const& tv) noexcept
+		{
+			auto const dot{ tv.rfind('.') };
+
+			return dot == std::string_view::npos ? tv : tv.substr(dot + 1);
+		}
+
+		// column name qualified with the name of its schema ("collected" and "title" name "collected.title")
+		template <cexpr::string Schema, cexpr::string Column>
+		constexpr auto qualify() noexcept
+		{
+			std::array<char, Schema.size() + Column.size() + 1> text{};
+
+			std::copy(Schema.cbegin(), Schema.cend(), text.begin());
+			text[Schema.size()] = '.';
+			std::copy(Column.cbegin(), Column.cend(), text.begin() + Schema.size() + 1);
+
+			return cexpr::string<char, text.size() + 1>{ std::string_view{ text.data(), text.size() } };
+		}
+
+		// Row with the columns sharing a name with a column of Shadow renamed to names qualified with Schema
+		template <cexpr::string Schema, typename Row, typename Shadow>
+		constexpr auto qualified()
+		{
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return sql::void_row{};
+			}
+			else
+			{
+				using next = decltype(qualified<Schema, typename Row::next, Shadow>());
+
+				if constexpr (sql::exists<Row::column::name, Shadow>())
+				{
+					constexpr auto name{ qualify<Schema, Row::column::name>() };
+
+					return sql::row<sql::column<name, typename Row::column::type>, next>{};
+				}
+				else
+				{
+					return sql::row<typename Row::column, next>{};
+				}
+			}
+		}
+
+		constexpr bool isintegral(std::string_view const& tv) noexcept
+		{
+			bool result{ false };
+
+			for (auto c : tv)
+			{
+				result |= (c == '.');
+			}
+
+			return !result;
+		}
+
+		// true when the token is an unsigned integer
+		constexpr bool isnumber(std::string_view const& tv) noexcept
+		{
+			bool result{ !tv.empty() };
+
+			for (auto c : tv)
+			{
+				result &= (c >= '0' && c <= '9');
+			}
+
+			return result;
+		}
+
+		// value of an unsigned integer token such as a row count
+		constexpr std::size_t tocount(std::string_view const& tv) noexcept
+		{
+			std::size_t acc{};
+
+			for (auto c : tv)
+			{
+				acc = acc * 10 + static_cast<std::size_t>(c - '0');
+			}
+
+			return acc;
+		}
+
+		constexpr bool isdigit(char c) noexcept
+		{
+			return (c >= '0' && c <= '9') || c == '-' || c == '.';
+		}
+
+		// the empty token closing the query is no operator, so a parenthesized predicate can end it
+		constexpr bool iscomp(std::string_view const& tv) noexcept
+		{
+			return !tv.empty() && (tv[0] == '=' || tv[0] == '!' || tv[0] == '<' || tv[0] == '>');
+		}
+
+		constexpr bool iscolumn(std::string_view const& tv) noexcept
+		{
+			return !iscomma(tv) && !isas(tv) && !isfrom(tv);
+		}
+
+		constexpr bool isseparator(std::string_view const& tv) noexcept
+		{
+			return iscomma(tv) || isfrom(tv);
+		}
+
+	} // namespace
+
+	// structured binding compliant iterator for query objects
+	template <typename Expr>
+	class query_iterator
+	{
+	public:
+		using row_type = std::remove_cvref_t<typename Expr::output_type>;
+
+		// fetches the first row, a null expression marks the end iterator
+		query_iterator(Expr* expr) : expr_{ expr }, row_{ expr == nullptr ? nullptr : expr->next() }
+		{}
+
+		inline bool operator==(query_iterator const& it) const noexcept
+		{
+			return (row_ == nullptr) == (it.row_ == nullptr);
+		}
+
+		inline bool operator!=(query_iterator const& it) const noexcept
+		{
+			return !(*this == it);
+		}
+
+		// the row is owned by the expression tree and stays valid until the iterator is incremented
+		inline row_type const& operator*() const noexcept
+		{
+			return *row_;
+		}
+
+		query_iterator& operator++()
+		{
+			if (row_ != nullptr)
+			{
+				row_ = expr_->next();
+			}
+
+			return *this;
+		}
+
+	private:
+		Expr* expr_{};
+		row_type const* row_{};
+	};
+
+	// view over a single batch of query output rows
+	template <typename Row>
+	class batch
+	{
+	public:
+		class iterator
+		{
+		public:
+			iterator(Row const* const* curr) : curr_{ curr }
+			{}
+
+			inline bool operator==(iterator const& it) const noexcept
+			{
+				return curr_ == it.curr_;
+			}
+
+			inline bool operator!=(iterator const& it) const noexcept
+			{
+				return !(*this == it);
+			}
+
+			inline Row const& operator*() const noexcept
+			{
+				return **curr_;
+			}
+
+			inline iterator& operator++() noexcept
+			{
+				++curr_;
+
+				return *this;
+			}
+
+		private:
+			Row const* const* curr_;
+		};
+
+		batch(std::span<Row const* const> rows) : rows_{ rows }
+		{}
+
+		inline std::size_t size() const noexcept
+		{
+			return rows_.size();
+		}
+
+		inline Row const& operator[](std::size_t i) const noexcept
+		{
+			return *rows_[i];
+		}
+
+		inline iterator begin() const noexcept
+		{
+			return iterator{ rows_.data() };
+		}
+
+		inline iterator end() const noexcept
+		{
+			return iterator{ rows_.data() + rows_.size() };
+		}
+
+	private:
+		std::span<Row const* const> rows_;
+	};
+
+	// iterator over batches of up to Size query output rows
+	template <typename Expr, std::size_t Size>
+	class batch_iterator
+	{
+	public:
+		using row_type = std::remove_cvref_t<typename Expr::output_type>;
+
+		// fills the first batch for dereference, a null expression marks the end iterator
+		batch_iterator(Expr* expr) : end_{ expr == nullptr }, expr_{ expr }, rows_(end_ ? 0 : Size), size_{}
+		{
+			operator++();
+		}
+
+		inline bool operator==(batch_iterator const& it) const noexcept
+		{
+			return end_ == it.end_;
+		}
+
+		inline bool operator!=(batch_iterator const& it) const noexcept
+		{
+			return !(*this == it);
+		}
+
+		inline batch<row_type> operator*() const noexcept
+		{
+			return batch<row_type>{ std::span{ rows_.data(), size_ } };
+		}
+
+		batch_iterator& operator++()
+		{
+			if (!end_)
+			{
+				size_ = expr_->next_batch(std::span{ rows_ });
+				end_ = size_ == 0;
+			}
+
+			return *this;
+		}
+
+	private:
+		bool end_{};
+		Expr* expr_{};
+		std::vector<row_type const*> rows_{};
+		std::size_t size_{};
+	};
+
+	// range loop wrapper returned by query::batches
+	template <typename Expr, std::size_t Size>
+	class batch_range
+	{
+	public:
+		using iterator = batch_iterator<Expr, Size>;
+
+		batch_range(Expr* expr) : expr_{ expr }
+		{}
+
+		inline iterator begin() const
+		{
+			return iterator{ expr_ };
+		}
+
+		inline iterator end() const
+		{
+			return iterator{ nullptr };
+		}
+
+	private:
+		Expr* expr_;
+	};
+
+	// output order of query::parallel, schema order or the order chunks finish in
+	enum class merge
+	{
+		ordered,
+		unordered
+	};
+
+	// View selects rows of string views into the schema storage over rows of copied values
+	template <cexpr::string Str, bool View, typename... Schemas>
+	class basic_query
+	{
+	private:
+		// name of the possibly schema qualified column token at Pos in the Row rows, a qualified name is kept when the rows
+		//	carry a column of that name, which are the right columns a join qualified with their schema
+		template <std::size_t Pos, typename Row>
+		static constexpr std::string_view resolve() noexcept
+		{
+			constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+
+			if constexpr (sql::exists<name, Row>())
+			{
+				return tokens_[Pos];
+			}
+			else
+			{
+				return unqualified(tokens_[Pos]);
+			}
+		}
+
+		// where predicate terminal parsing 
+		template <std::size_t Pos, typename Row>
+		static constexpr auto parse_terms()
+		{
+			if constexpr (tokens_[Pos] == "(")
+			{
+				constexpr auto next{ parse_or<Pos + 1, Row>() };
+
+				using node = typename decltype(next)::node;
+
+				static_assert(tokens_[next.pos] == ")", "No closing paranthesis found.");
+
+				return context<next.pos + 1, node>{};
+			}
+			else if constexpr (isquote(tokens_[Pos]))
+			{
+				constexpr cexpr::string<char, tokens_[Pos + 1].length() + 1> name{ tokens_[Pos + 1] };
+
+				using str = decltype(name);
+				using node = sql::constant<value<str>{ name }, Row>;
+
+				static_assert(isquote(tokens_[Pos + 2]), "No closing quote found.");
+
+				return context<Pos + 3, node>{};
+			}
+			else if constexpr (isdigit(tokens_[Pos][0]))
+			{
+				constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+				
+				using val = decltype(isintegral(tokens_[Pos]) ? std::int64_t{} : double{});
+				using node = sql::constant<sql::convert<val>(name), Row>;
+
+				return context<Pos + 1, node>{};
+			}
+			else
+			{
+				constexpr cexpr::string<char, resolve<Pos, Row>().length() + 1> name{ resolve<Pos, Row>() };
+
+				using node = sql::variable<name, Row>;
+
+				return context<Pos + 1, node>{};
 			}
+		}
 
-			if (curr != end && *curr == dot)
+		// parses a single compare operation
+		template <typename Left, typename Row>
+		static constexpr auto recurse_comparison()
+		{
+			if constexpr (!iscomp(tokens_[Left::pos]))
 			{
-				scalar = 1;
-				++curr;
+				return Left{};
+			}
+			else
+			{
+				constexpr auto next{ parse_terms<Left::pos + 1, Row>() };
+				constexpr cexpr::string<char, tokens_[Left::pos].length() + 1> name{ tokens_[Left::pos] };
 
-				while(curr != end)
+				using ranode = typename decltype(next)::node;
+				using node = sql::operation<name, Row, typename Left::node, ranode>;
+
+				return context<next.pos, node>{};
+			}			
+		}
+
+		// descend further and attempt to parse a compare operation
+		template <std::size_t Pos, typename Row>
+		static constexpr auto parse_comparison()
+		{
+			using left = decltype(parse_terms<Pos, Row>());
+			
+			return recurse_comparison<left, Row>();
+		}
+
+		// attempt to parse a negation operation then descend further
+		template <std::size_t Pos, typename Row>
+		static constexpr auto parse_negation()
+		{
+			if constexpr (isnot(tokens_[Pos]))
+			{
+				constexpr auto next{ parse_comparison<Pos + 1, Row>() };
+
+				using ranode = typename decltype(next)::node;
+				using node = sql::operation<"NOT", Row, ranode>;
+
+				return context<next.pos, node>{};
+			}
+			else
+			{
+				return parse_comparison<Pos, Row>();
+			}
+		}
+
+		// recursively parse chained AND operations
+		template <typename Left, typename Row>
+		static constexpr auto recurse_and()
+		{
+			if constexpr (!isand(tokens_[Left::pos]))
+			{
+				return Left{};
+			}
+			else
+			{
+				constexpr auto next{ parse_negation<Left::pos + 1, Row>() };
+
+				using ranode = typename decltype(next)::node;
+				using node = sql::operation<"AND", Row, typename Left::node, ranode>;
+
+				return recurse_and<context<next.pos, node>, Row>();
+			}
+		}
+
+		// descend further then attempt to parse AND operations
+		template <std::size_t Pos, typename Row>
+		static constexpr auto parse_and()
+		{
+			using left = decltype(parse_negation<Pos, Row>());
+			
+			return recurse_and<left, Row>();
+		}
+		
+		// recursively parse chained OR operations
+		template <typename Left, typename Row>
+		static constexpr auto recurse_or()
+		{
+			if constexpr (!isor(tokens_[Left::pos]))
+			{
+				return Left{};
+			}
+			else
+			{
+				constexpr auto next{ parse_and<Left::pos + 1, Row>() };
+				
+				using ranode = typename decltype(next)::node;
+				using node = sql::operation<"OR", Row, typename Left::node, ranode>;
+
+				return recurse_or<context<next.pos, node>, Row>();
+			}
+		}
+
+		// descend further then attempt to parse OR operations
+		template <std::size_t Pos, typename Row>
+		static constexpr auto parse_or()
+		{
+			using left = decltype(parse_and<Pos, Row>());
+			
+			return recurse_or<left, Row>();
+		}
+
+		// true if any token names the column, is a wildcard other than the one of COUNT(*), or joins naturally on a leading column
+		template <cexpr::string Name, bool Leading>
+		static constexpr bool referenced() noexcept
+		{
+			std::string_view name{ Name.cbegin(), Name.size() };
+
+			for (std::size_t i{}; i < tokens_.count(); ++i)
+			{
+				bool const wildcard{ tokens_[i] == "*" && (i == 0 || tokens_[i - 1] != "(") };
+
+				if (unqualified(tokens_[i]) == name || wildcard || (Leading && isnatural(tokens_[i])))
 				{
-					acc += (*curr - zro) * (scalar /= Type{ 10 });
-					++curr;
+					return true;
 				}
 			}
 
-			return value<Type>{ acc * sign };
+			return false;
 		}
 
-		inline constexpr bool isquote(std::string_view const& tv) noexcept
+		// row of the columns in Row which are read by the query
+		template <typename Row, bool Leading = true>
+		static constexpr auto referenced_columns()
 		{
-			return tv == "\"" || tv == "'";
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return sql::void_row{};
+			}
+			else
+			{
+				using next = decltype(referenced_columns<typename Row::next, false>());
+
+				if constexpr (referenced<Row::column::name, Leading>())
+				{
+					return sql::row<typename Row::column, next>{};
+				}
+				else
+				{
+					return next{};
+				}
+			}
 		}
 
-		inline constexpr bool isor(std::string_view const& tv) noexcept
+		// find correct schema for terminal relation
+		template <cexpr::string Name, std::size_t Id, typename Schema, typename... Others>
+		static constexpr auto recurse_schemas()
 		{
-			return tv == "OR" || tv == "or";
+			if constexpr (Name == Schema::name)
+			{
+				using columns = decltype(referenced_columns<typename Schema::row_type>());
+
+				return ra::relation<Schema, Id, columns>{};
+			}
+			else
+			{
+				static_assert(sizeof...(Others) != 0, "Schema name used in JOIN was not provided.");
+
+				return recurse_schemas<Name, Id, Others...>();
+			}
 		}
 
-		inline constexpr bool isand(std::string_view const& tv) noexcept
+		// wrapper function to determine terminal relation
+		template <std::size_t Pos>
+		static constexpr auto parse_schema()
 		{
-			return tv == "AND" || tv == "and";
+			if constexpr (tokens_[Pos] == "(")
+			{
+				constexpr auto next{ parse_root<Pos + 1>() };
+				
+				using node = typename decltype(next)::node;
+
+				static_assert(tokens_[next.pos] == ")", "No closing paranthesis found.");
+
+				return context<next.pos + 1, node>{};
+			}
+			else
+			{
+				constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+
+				using node = decltype(recurse_schemas<name, Pos, Schemas...>());
+
+				return context<Pos + 1, node>{};
+			}
 		}
 
-		inline constexpr bool isnot(std::string_view const& tv) noexcept
+		// hash joins of two scans build over whichever input holds fewer rows once seeded, the inputs
+		//	of other joins are not sized so their tables are built over the right input
+		template <typename Left, typename Right>
+		static constexpr ra::side build_side() noexcept
 		{
-			return tv == "NOT" || tv == "not";
+			if constexpr (scan<Left>::value && scan<Right>::value)
+			{
+				return ra::side::smaller;
+			}
+			else
+			{
+				return ra::side::right;
+			}
 		}
 
-		inline constexpr bool isnatural(std::string_view const& tv) noexcept
+		// Row of the Right input with the columns sharing a name with a LeftCols column qualified with the name of the
+		//	schema Right scans, so a join keeps them beside the left columns, rows of other inputs keep their names
+		template <typename Right, typename LeftCols, typename Row = std::remove_cvref_t<typename Right::output_type>>
+		static constexpr auto qualified_row()
 		{
-			return tv == "NATURAL" || tv == "natural";
+			if constexpr (scan<Right>::value)
+			{
+				return qualified<scan<Right>::schema::name, Row, LeftCols>();
+			}
+			else
+			{
+				return Row{};
+			}
 		}
 
-		inline constexpr bool isjoin(std::string_view const& tv) noexcept
+		// Right renamed to its qualified row, inputs without a column to qualify are not renamed
+		template <typename Right, typename LeftCols>
+		static constexpr auto qualified_input()
 		{
-			return tv == "JOIN" || tv == "join";
+			using row = decltype(qualified_row<Right, LeftCols>());
+
+			if constexpr (std::is_same_v<row, std::remove_cvref_t<typename Right::output_type>>)
+			{
+				return Right{};
+			}
+			else
+			{
+				return ra::rename<row, Right>{};
+			}
 		}
 
-		inline constexpr bool iswhere(std::string_view const& tv) noexcept
+		// name the Name column of the Right input has in its qualified row
+		template <typename Right, typename LeftCols, cexpr::string Name>
+		static constexpr auto qualified_name()
 		{
-			return tv == "WHERE" || tv == "where";
+			if constexpr (scan<Right>::value && sql::exists<Name, LeftCols>())
+			{
+				return qualify<scan<Right>::schema::name, Name>();
+			}
+			else
+			{
+				return Name;
+			}
 		}
 
-		inline constexpr bool isfrom(std::string_view const& tv) noexcept
+		// stub which will choose the specific join RA node, the join only carries the columns the query reads,
+		//	inputs sorted on their join keys are merged and a right input indexed on its key is probed instead of hashed
+		template <std::size_t Pos, typename Left, typename Right>
+		static constexpr auto choose_join()
 		{
-			return tv == "FROM" || tv == "from";
+			using lcols = decltype(referenced_columns<std::remove_cvref_t<typename Left::output_type>>());
+			using rcols = decltype(referenced_columns<std::remove_cvref_t<typename Right::output_type>>());
+
+			constexpr auto lkey{ std::remove_cvref_t<typename Left::output_type>::column::name };
+			constexpr auto rkey{ std::remove_cvref_t<typename Right::output_type>::column::name };
+
+			if constexpr (isnatural(tokens_[Pos]) && ordered<Left, lkey>() && ordered<Right, rkey>())
+			{
+				return ra::sorted<Left, Right, lkey, rkey, lcols, rcols>{};
+			}
+			else if constexpr (isnatural(tokens_[Pos]) && seekable<Right>::value && ordered<Right, rkey>())
+			{
+				return ra::indexed<Left, Right, lkey, rkey, lcols, rcols>{};
+			}
+			else if constexpr (isnatural(tokens_[Pos]))
+			{
+				return ra::natural<Left, Right, lcols, rcols, build_side<Left, Right>()>{};
+			}
+			else
+			{
+				using right = decltype(qualified_input<Right, lcols>());
+
+				return ra::cross<Left, right, lcols, decltype(qualified_row<Right, lcols, rcols>())>{};
+			}
 		}
 
-		inline constexpr bool isas(std::string_view const& tv) noexcept
+		// true when the ON clause column at Pos is qualified with the name of the schema Node scans
+		template <std::size_t Pos, typename Node>
+		static constexpr bool qualifies()
 		{
-			return tv == "AS" || tv == "as";
+			if constexpr (scan<Node>::value)
+			{
+				constexpr auto name{ scan<Node>::schema::name };
+				constexpr auto column{ tokens_[Pos] };
+
+				return column.size() > name.size() && column[name.size()] == '.' && column.substr(0, name.size()) == std::string_view{ name.cbegin(), name.size() };
+			}
+			else
+			{
+				return false;
+			}
 		}
 
-		inline constexpr bool isselect(std::string_view const& tv) noexcept
+		// inner joins merge inputs sorted on their keys, probe a right input indexed on its key, or otherwise hash the right input
+		template <typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		static constexpr auto choose_inner()
 		{
-			return tv == "SELECT" || tv == "select";
+			if constexpr (ordered<Left, LeftKey>() && ordered<Right, RightKey>())
+			{
+				return ra::sorted<Left, Right, LeftKey, RightKey, LeftCols, RightCols>{};
+			}
+			else if constexpr (seekable<Right>::value && ordered<Right, RightKey>())
+			{
+				return ra::indexed<Left, Right, LeftKey, RightKey, LeftCols, RightCols>{};
+			}
+			else
+			{
+				return ra::inner<Left, Right, LeftKey, RightKey, LeftCols, RightCols, build_side<Left, Right>()>{};
+			}
 		}
 
-		inline constexpr bool iscomma(std::string_view const& tv) noexcept
+		// outer joins hash their inputs and keep the right columns sharing a name with a left column under their qualified
+		//	names, as a padded column and the one of the same name hold different values, inner joins are chosen by choose_inner
+		template <std::size_t Kind, typename Left, typename Right, cexpr::string LeftKey, cexpr::string RightKey, typename LeftCols, typename RightCols>
+		static constexpr auto choose_equi()
 		{
-			return tv == ",";
+			using right = decltype(qualified_input<Right, LeftCols>());
+			using rcols = decltype(qualified_row<Right, LeftCols, RightCols>());
+
+			constexpr auto rkey{ qualified_name<Right, LeftCols, RightKey>() };
+
+			if constexpr (isleft(tokens_[Kind]))
+			{
+				return ra::outer<Left, right, LeftKey, rkey, LeftCols, rcols, ra::keep::left>{};
+			}
+			else if constexpr (isright(tokens_[Kind]))
+			{
+				return ra::outer<Left, right, LeftKey, rkey, LeftCols, rcols, ra::keep::right>{};
+			}
+			else if constexpr (isfull(tokens_[Kind]))
+			{
+				return ra::outer<Left, right, LeftKey, rkey, LeftCols, rcols, ra::keep::both>{};
+			}
+			else
+			{
+				return choose_inner<Left, Right, LeftKey, RightKey, LeftCols, RightCols>();
+			}
 		}
 
-		constexpr bool isintegral(std::string_view const& tv) noexcept
-		{
-			bool result{ false };
+		// parses the ON clause equality at Pos into a join of the kind named at Kind keyed on the named column of each input
+		template <std::size_t Pos, std::size_t Kind, typename Left, typename Right>
+		static constexpr auto parse_on()
+		{
+			static_assert(Pos + 3 < tokens_.count() && ison(tokens_[Pos]), "Expected 'ON' token following joined schema.");
+			static_assert(tokens_[Pos + 2] == "=", "Expected '=' between columns of the ON clause.");
+
+			constexpr cexpr::string<char, unqualified(tokens_[Pos + 1]).length() + 1> first{ unqualified(tokens_[Pos + 1]) };
+			constexpr cexpr::string<char, unqualified(tokens_[Pos + 3]).length() + 1> second{ unqualified(tokens_[Pos + 3]) };
+
+			using lrow = std::remove_cvref_t<typename Left::output_type>;
+			using rrow = std::remove_cvref_t<typename Right::output_type>;
+			using lcols = decltype(referenced_columns<lrow>());
+			using rcols = decltype(referenced_columns<rrow>());
+
+			constexpr bool forward{ sql::exists<first, lrow>() && sql::exists<second, rrow>() };
+			constexpr bool backward{ sql::exists<second, lrow>() && sql::exists<first, rrow>() };
+
+			static_assert(forward || backward, "ON clause must compare a column of each joined input.");
 
-			for (auto c : tv)
+			// columns present in both inputs are placed by their schema qualifier
+			if constexpr (forward && !(backward && qualifies<Pos + 1, Right>()))
 			{
-				result |= (c == '.');
+				return context<Pos + 4, decltype(choose_equi<Kind, Left, Right, first, second, lcols, rcols>())>{};
+			}
+			else
+			{
+				return context<Pos + 4, decltype(choose_equi<Kind, Left, Right, second, first, lcols, rcols>())>{};
 			}
-
-			return !result;
 		}
 
-		constexpr bool isdigit(char c) noexcept
+		// true when every column Predicate reads from Row belongs to Side and is not hidden by Shadow, a void Side reads nothing
+		template <typename Predicate, typename Row, typename Side, typename Shadow>
+		static constexpr bool readable()
 		{
-			return (c >= '0' && c <= '9') || c == '-' || c == '.';
+			if constexpr (std::is_same_v<Row, sql::void_row>)
+			{
+				return !std::is_same_v<Side, sql::void_row>;
+			}
+			else if constexpr (Predicate::template reads<Row::column::name>() && (!sql::exists<Row::column::name, Side>() || sql::exists<Row::column::name, Shadow>()))
+			{
+				return false;
+			}
+			else
+			{
+				return readable<Predicate, typename Row::next, Side, Shadow>();
+			}
 		}
 
-		constexpr bool iscomp(char c) noexcept
+		// conjunction of two predicates over Row where void stands for no predicate
+		template <typename Row, typename Left, typename Right>
+		static constexpr auto conjoin()
 		{
-			return c == '=' || c == '!' || c == '<' || c == '>';
+			if constexpr (std::is_void_v<Left>)
+			{
+				return std::type_identity<Right>{};
+			}
+			else if constexpr (std::is_void_v<Right>)
+			{
+				return std::type_identity<Left>{};
+			}
+			else
+			{
+				return std::type_identity<sql::operation<"AND", Row, Left, Right>>{};
+			}
 		}
 
-		constexpr bool iscolumn(std::string_view const& tv) noexcept
+		// top level AND conjuncts of Predicate which can be evaluated over Side, rebound to its rows
+		template <typename Predicate, typename Row, typename Side, typename Shadow>
+		static constexpr auto pushdown()
 		{
-			return !iscomma(tv) && !isas(tv) && !isfrom(tv);
-		}
+			if constexpr (conjunction<Predicate>::value)
+			{
+				using left = typename decltype(pushdown<typename conjunction<Predicate>::left, Row, Side, Shadow>())::type;
+				using right = typename decltype(pushdown<typename conjunction<Predicate>::right, Row, Side, Shadow>())::type;
 
-		constexpr bool isseparator(std::string_view const& tv) noexcept
-		{
-			return iscomma(tv) || isfrom(tv);
+				return conjoin<Side, left, right>();
+			}
+			else if constexpr (readable<Predicate, Row, Side, Shadow>())
+			{
+				return std::type_identity<typename Predicate::template rebind<Side>>{};
+			}
+			else
+			{
+				return std::type_identity<void>{};
+			}
 		}
 
-	} // namespace
-
-	// structured binding compliant iterator for query objects
-	template <typename Expr>
-	class query_iterator
-	{
-	public:
-		using row_type = std::remove_cvref_t<typename Expr::output_type>;
-
-		// seeds row datamember for first dereference
-		query_iterator(bool end) : end_{ end }, row_{}
+		// top level AND conjuncts of Predicate which neither join input can evaluate
+		template <typename Predicate, typename Row, typename Left, typename Right, typename Shadow>
+		static constexpr auto residual()
 		{
-			operator++();
-		}
+			if constexpr (conjunction<Predicate>::value)
+			{
+				using left = typename decltype(residual<typename conjunction<Predicate>::left, Row, Left, Right, Shadow>())::type;
+				using right = typename decltype(residual<typename conjunction<Predicate>::right, Row, Left, Right, Shadow>())::type;
 
-		inline bool operator==(query_iterator const& it) const noexcept
-		{
-			return end_ == it.end_;
+				return conjoin<Row, left, right>();
+			}
+			else if constexpr (readable<Predicate, Row, Left, sql::void_row>() || readable<Predicate, Row, Right, Shadow>())
+			{
+				return std::type_identity<void>{};
+			}
+			else
+			{
+				return std::type_identity<Predicate>{};
+			}
 		}
 
-		inline bool operator!=(query_iterator const& it) const noexcept
+		// true when Column is read from Side in the rows of a join, a right column of the same name as a
+		//	left column is hidden by it, and its values are never null so hashing them matches sql equality
+		template <cexpr::string Column, typename Side, typename Shadow>
+		static constexpr bool keyable() noexcept
 		{
-			return !(*this == it);
+			if constexpr (sql::exists<Column, Side>() && !sql::exists<Column, Shadow>())
+			{
+				return !nullable_type<std::remove_cvref_t<decltype(sql::get<Column>(Side{}))>>::value;
+			}
+			else
+			{
+				return false;
+			}
 		}
 
-		inline row_type const& operator*() const noexcept
+		// LeftKey and RightKey hash together when they are keys of their inputs with the same type
+		template <cexpr::string LeftKey, cexpr::string RightKey, typename Left, typename Right, typename Shadow>
+		static constexpr bool hashable() noexcept
 		{
-			return row_;
+			if constexpr (keyable<LeftKey, Left, sql::void_row>() && keyable<RightKey, Right, Shadow>())
+			{
+				using left = std::remove_cvref_t<decltype(sql::get<LeftKey>(Left{}))>;
+				using right = std::remove_cvref_t<decltype(sql::get<RightKey>(Right{}))>;
+
+				return std::is_same_v<left, right>;
+			}
+			else
+			{
+				return false;
+			}
 		}
 
-		query_iterator& operator++()
+		// first top level AND conjunct of Predicate equating a column of Left with a column of Right, or void
+		template <typename Predicate, typename Left, typename Right, typename Shadow>
+		static constexpr auto equate()
 		{
-			if (!end_)
+			if constexpr (conjunction<Predicate>::value)
 			{
-				try
+				using left = typename decltype(equate<typename conjunction<Predicate>::left, Left, Right, Shadow>())::type;
+
+				if constexpr (std::is_void_v<left>)
 				{
-					row_ = Expr::next();
+					return equate<typename conjunction<Predicate>::right, Left, Right, Shadow>();
 				}
-				catch (ra::data_end const& e)
+				else
 				{
-					end_ = true;
+					return std::type_identity<left>{};
 				}
 			}
-
-			return *this;
-		}
-
-	private:
-		bool end_{};
-		row_type row_{};
-	};
-
-	template <cexpr::string Str, typename... Schemas>
-	class query
-	{
-	private:
-		// where predicate terminal parsing 
-		template <std::size_t Pos, typename Row>
-		static constexpr auto parse_terms()
-		{
-			if constexpr (tokens_[Pos] == "(")
+			else if constexpr (!equality<Predicate>::value)
 			{
-				constexpr auto next{ parse_or<Pos + 1, Row>() };
-
-				using node = typename decltype(next)::node;
-
-				static_assert(tokens_[next.pos] == ")", "No closing paranthesis found.");
-
-				return context<next.pos + 1, node>{};
+				return std::type_identity<void>{};
 			}
-			else if constexpr (isquote(tokens_[Pos]))
+			else if constexpr (hashable<equality<Predicate>::left, equality<Predicate>::right, Left, Right, Shadow>())
 			{
-				constexpr cexpr::string<char, tokens_[Pos + 1].length() + 1> name{ tokens_[Pos + 1] };
-
-				using str = decltype(name);
-				using node = sql::constant<value<str>{ name }, Row>;
-
-				static_assert(isquote(tokens_[Pos + 2]), "No closing quote found.");
-
-				return context<Pos + 3, node>{};
+				return std::type_identity<keyed<equality<Predicate>::left, equality<Predicate>::right, Predicate>>{};
 			}
-			else if constexpr (isdigit(tokens_[Pos][0]))
+			else if constexpr (hashable<equality<Predicate>::right, equality<Predicate>::left, Left, Right, Shadow>())
 			{
-				constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
-				
-				using val = decltype(isintegral(tokens_[Pos]) ? std::int64_t{} : double{});
-				using node = sql::constant<sql::convert<val>(name), Row>;
-
-				return context<Pos + 1, node>{};
+				return std::type_identity<keyed<equality<Predicate>::right, equality<Predicate>::left, Predicate>>{};
 			}
 			else
 			{
-				constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
-
-				using node = sql::variable<name, Row>;
-
-				return context<Pos + 1, node>{};
+				return std::type_identity<void>{};
 			}
 		}
 
-		// parses a single compare operation
-		template <typename Left, typename Row>
-		static constexpr auto recurse_comparison()
+		// Predicate over Row without its top level AND conjuncts of type Conjunct, void when none remain
+		template <typename Predicate, typename Row, typename Conjunct>
+		static constexpr auto drop()
 		{
-			if constexpr (!iscomp(tokens_[Left::pos][0]))
+			if constexpr (conjunction<Predicate>::value)
 			{
-				return Left{};
+				using left = typename decltype(drop<typename conjunction<Predicate>::left, Row, Conjunct>())::type;
+				using right = typename decltype(drop<typename conjunction<Predicate>::right, Row, Conjunct>())::type;
+
+				return conjoin<Row, left, right>();
+			}
+			else if constexpr (std::is_same_v<Predicate, Conjunct>)
+			{
+				return std::type_identity<void>{};
 			}
 			else
 			{
-				constexpr auto next{ parse_terms<Left::pos + 1, Row>() };
-				constexpr cexpr::string<char, tokens_[Left::pos].length() + 1> name{ tokens_[Left::pos] };
-
-				using ranode = typename decltype(next)::node;
-				using node = sql::operation<name, Row, typename Left::node, ranode>;
-
-				return context<next.pos, node>{};
-			}			
-		}
-
-		// descend further and attempt to parse a compare operation
-		template <std::size_t Pos, typename Row>
-		static constexpr auto parse_comparison()
-		{
-			using left = decltype(parse_terms<Pos, Row>());
-			
-			return recurse_comparison<left, Row>();
+				return std::type_identity<Predicate>{};
+			}
 		}
 
-		// attempt to parse a negation operation then descend further
-		template <std::size_t Pos, typename Row>
-		static constexpr auto parse_negation()
+		// a cross join filtered on the equality of a column of each input is joined on those columns instead, the
+		//	rest of the predicate is placed over the equi join, void when Node is no such cross join
+		template <typename Predicate, typename Node>
+		static constexpr auto rehash()
 		{
-			if constexpr (isnot(tokens_[Pos]))
+			if constexpr (product<Node>::value)
 			{
-				constexpr auto next{ parse_comparison<Pos + 1, Row>() };
+				using inputs = product<Node>;
+				using row = std::remove_cvref_t<typename Node::output_type>;
+				using lrow = std::remove_cvref_t<typename inputs::left::output_type>;
+				using rrow = std::remove_cvref_t<typename inputs::right::output_type>;
 
-				using ranode = typename decltype(next)::node;
-				using node = sql::operation<"NOT", Row, ranode>;
+				using keys = typename decltype(equate<Predicate, lrow, rrow, typename inputs::left_columns>())::type;
 
-				return context<next.pos, node>{};
+				if constexpr (std::is_void_v<keys>)
+				{
+					return std::type_identity<void>{};
+				}
+				else
+				{
+					using join = decltype(choose_inner<typename inputs::left, typename inputs::right, keys::left_key, keys::right_key,
+						typename inputs::left_columns, typename inputs::right_columns>());
+					using rest = typename decltype(drop<Predicate, row, typename keys::conjunct>())::type;
+
+					return std::type_identity<decltype(parse_selection<rest, join>())>{};
+				}
 			}
 			else
 			{
-				return parse_comparison<Pos, Row>();
+				return std::type_identity<void>{};
 			}
 		}
 
-		// recursively parse chained AND operations
-		template <typename Left, typename Row>
-		static constexpr auto recurse_and()
+		// places a selection over Node, pushing conjuncts below joins to the inputs which own their columns
+		template <typename Predicate, typename Node>
+		static constexpr auto parse_selection()
 		{
-			if constexpr (!isand(tokens_[Left::pos]))
+			if constexpr (std::is_void_v<Predicate>)
 			{
-				return Left{};
+				return Node{};
 			}
-			else
+			else if constexpr (!std::is_void_v<typename decltype(rehash<Predicate, Node>())::type>)
 			{
-				constexpr auto next{ parse_negation<Left::pos + 1, Row>() };
+				return typename decltype(rehash<Predicate, Node>())::type{};
+			}
+			else if constexpr (join_inputs<Node>::value)
+			{
+				using inputs = join_inputs<Node>;
+				using row = std::remove_cvref_t<typename Node::output_type>;
+				using lrow = std::conditional_t<padding<Node>::left, sql::void_row, std::remove_cvref_t<typename inputs::left::output_type>>;
+				using rrow = std::conditional_t<padding<Node>::right, sql::void_row, std::remove_cvref_t<typename inputs::right::output_type>>;
 
-				using ranode = typename decltype(next)::node;
-				using node = sql::operation<"AND", Row, typename Left::node, ranode>;
+				using lpred = typename decltype(pushdown<Predicate, row, lrow, sql::void_row>())::type;
+				using rpred = typename decltype(pushdown<Predicate, row, rrow, typename inputs::shadow>())::type;
+				using rest = typename decltype(residual<Predicate, row, lrow, rrow, typename inputs::shadow>())::type;
 
-				return recurse_and<context<next.pos, node>, Row>();
+				using lnode = decltype(parse_selection<lpred, typename inputs::left>());
+				using rnode = decltype(parse_selection<rpred, typename inputs::right>());
+
+				using join = typename inputs::template rebuild<lnode, rnode>;
+
+				if constexpr (std::is_void_v<rest>)
+				{
+					return join{};
+				}
+				else
+				{
+					return ra::selection<rest, join>{};
+				}
+			}
+			else
+			{
+				return ra::selection<Predicate, Node>{};
 			}
 		}
 
-		// descend further then attempt to parse AND operations
-		template <std::size_t Pos, typename Row>
-		static constexpr auto parse_and()
+		// one past the JOIN keyword of a JOIN, INNER JOIN, or LEFT, RIGHT, and FULL [OUTER] JOIN clause starting at pos
+		static constexpr std::size_t join_end(std::size_t pos) noexcept
 		{
-			using left = decltype(parse_negation<Pos, Row>());
-			
-			return recurse_and<left, Row>();
+			if (isjoin(tokens_[pos]))
+			{
+				return pos + 1;
+			}
+			else if (isouter(tokens_[pos + 1]))
+			{
+				return pos + 3;
+			}
+			else
+			{
+				return pos + 2;
+			}
 		}
-		
-		// recursively parse chained OR operations
-		template <typename Left, typename Row>
-		static constexpr auto recurse_or()
+
+		// recursively parses the joins chained onto Left into a left deep join tree in written order
+		template <typename Left>
+		static constexpr auto recurse_join()
 		{
-			if constexpr (!isor(tokens_[Left::pos]))
+			using lnode = typename Left::node;
+
+			if constexpr (Left::pos + 2 < tokens_.count() && isjoin(tokens_[Left::pos + 1]) && !isequi(tokens_[Left::pos]))
 			{
-				return Left{};
+				constexpr auto rnext{ parse_schema<Left::pos + 2>() };
+
+				using rnode = typename decltype(rnext)::node;
+				using join = decltype(choose_join<Left::pos, lnode, rnode>());
+
+				return recurse_join<context<rnext.pos, join>>();
 			}
-			else
+			else if constexpr (Left::pos + 1 < tokens_.count() && (isjoin(tokens_[Left::pos]) || isequi(tokens_[Left::pos])))
 			{
-				constexpr auto next{ parse_and<Left::pos + 1, Row>() };
-				
-				using ranode = typename decltype(next)::node;
-				using node = sql::operation<"OR", Row, typename Left::node, ranode>;
+				constexpr std::size_t rpos{ join_end(Left::pos) };
 
-				return recurse_or<context<next.pos, node>, Row>();
+				static_assert(isjoin(tokens_[rpos - 1]), "Expected 'JOIN' token following the join type.");
+
+				constexpr auto rnext{ parse_schema<rpos>() };
+
+				using rnode = typename decltype(rnext)::node;
+
+				return recurse_join<decltype(parse_on<rnext.pos, Left::pos, lnode, rnode>())>();
+			}
+			else
+			{
+				return Left{};
 			}
 		}
 
-		// descend further then attempt to parse OR operations
-		template <std::size_t Pos, typename Row>
-		static constexpr auto parse_or()
+		// parses the first relation and the joins chained onto it, else returns the single relation terminal
+		template <std::size_t Pos>
+		static constexpr auto parse_join()
 		{
-			using left = decltype(parse_and<Pos, Row>());
-			
-			return recurse_or<left, Row>();
+			constexpr auto lnext{ parse_schema<Pos>() };
+
+			return recurse_join<context<lnext.pos, typename decltype(lnext)::node>>();
 		}
 
-		// find correct schema for terminal relation
-		template <cexpr::string Name, std::size_t Id, typename Schema, typename... Others>
-		static constexpr auto recurse_schemas()
+		// columns the relations of Relations carry into the joins over them
+		template <typename Relations, std::size_t Id = 0>
+		static constexpr std::size_t carried() noexcept
 		{
-			if constexpr (Name == Schema::name)
+			if constexpr (Id == std::tuple_size_v<Relations>)
 			{
-				return ra::relation<Schema, Id>{};
+				return 0;
 			}
 			else
 			{
-				static_assert(sizeof...(Others) != 0, "Schema name used in JOIN was not provided.");
+				using row = std::remove_cvref_t<typename std::tuple_element_t<Id, Relations>::output_type>;
 
-				return recurse_schemas<Name, Id, Others...>();
+				return decltype(referenced_columns<row>())::depth + carried<Relations, Id + 1>();
 			}
 		}
 
-		// wrapper function to determine terminal relation
-		template <std::size_t Pos>
-		static constexpr auto parse_schema()
+		// joins the relations of Chain onto Node in its planned order from Step on, keying each join on the
+		//	columns of the link which joins the relation to the ones before it
+		template <typename Chain, std::size_t Step, typename Node>
+		static constexpr auto rejoin()
 		{
-			if constexpr (tokens_[Pos] == "(")
+			if constexpr (Step == Chain::size)
 			{
-				constexpr auto next{ parse_root<Pos + 1>() };
-				
-				using node = typename decltype(next)::node;
-
-				static_assert(tokens_[next.pos] == ")", "No closing paranthesis found.");
-
-				return context<next.pos + 1, node>{};
+				return Node{};
 			}
 			else
 			{
-				constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+				constexpr auto plan{ Chain::order() };
 
-				using node = decltype(recurse_schemas<name, Pos, Schemas...>());
+				using right = std::tuple_element_t<plan.ids[Step], typename Chain::relations>;
+				using link = std::tuple_element_t<plan.links[Step], typename Chain::links>;
+				using lcols = decltype(referenced_columns<std::remove_cvref_t<typename Node::output_type>>());
+				using rcols = decltype(referenced_columns<std::remove_cvref_t<typename right::output_type>>());
 
-				return context<Pos + 1, node>{};
+				if constexpr (link::right_id == plan.ids[Step])
+				{
+					return rejoin<Chain, Step + 1, decltype(choose_inner<Node, right, link::left_key, link::right_key, lcols, rcols>())>();
+				}
+				else
+				{
+					return rejoin<Chain, Step + 1, decltype(choose_inner<Node, right, link::right_key, link::left_key, lcols, rcols>())>();
+				}
 			}
 		}
 
-		// stub which will choose the specific join RA node
-		template <std::size_t Pos, typename Left, typename Right>
-		static constexpr auto choose_join()
+		// joins chains of three or more inner equi joins over hinted schemas smallest relation first, chains whose
+		//	relations share column names the links do not equate keep their order as the shared column would change
+		template <typename Node>
+		static constexpr auto reorder()
 		{
-			if constexpr (isnatural(tokens_[Pos]))
+			using chain = decltype(flatten<Node>());
+			using row = std::remove_cvref_t<typename Node::output_type>;
+
+			if constexpr (chain::size > 2 && chain::hinted && chain::typed && carried<typename chain::relations>() == row::depth + chain::equated && chain::reordered())
 			{
-				return ra::natural<Left, Right>{};
+				constexpr auto plan{ chain::order() };
+
+				return rejoin<chain, 1, std::tuple_element_t<plan.ids[0], typename chain::relations>>();
 			}
 			else
 			{
-				return ra::cross<Left, Right>{};	
+				return Node{};
 			}
 		}
 
-		// parses join colinfo if a join is present else returns the single relation terminal
-		template <std::size_t Pos>
-		static constexpr auto parse_join()
+		// projects a reordered join tree back to the column order of the written one when the query selects *
+		template <std::size_t Pos, typename Written, typename Node>
+		static constexpr auto restore()
 		{
-			constexpr auto lnext{ parse_schema<Pos>() };
+			using row = std::remove_cvref_t<typename Written::output_type>;
 
-			using lnode = typename decltype(lnext)::node;
-
-			if constexpr (lnext.pos + 2 < tokens_.count() && isjoin(tokens_[lnext.pos + 1]))
+			if constexpr (tokens_[Pos - 1] == "*" && !std::is_same_v<row, std::remove_cvref_t<typename Node::output_type>>)
 			{
-				constexpr auto rnext{ parse_schema<lnext.pos + 2>() };
-
-				using rnode = typename decltype(rnext)::node;
-				using join = decltype(choose_join<lnext.pos, lnode, rnode>());
-
-				return context<rnext.pos, join>{};
+				return ra::projection<row, Node>{};
 			}
 			else
 			{
-				return context<lnext.pos, lnode>{};
+				return Node{};
 			}
 		}
 
@@ -1662,7 +6136,8 @@ namespace sql
 
 			constexpr auto next{ parse_join<Pos + 1>() };
 
-			using node = typename decltype(next)::node;
+			using written = typename decltype(next)::node;
+			using node = decltype(reorder<written>());
 
 			if constexpr (next.pos < tokens_.count() && iswhere(tokens_[next.pos]))
 			{
@@ -1671,13 +6146,13 @@ namespace sql
 				constexpr auto predicate{ parse_or<next.pos + 1, output>() };
 
 				using pnext = typename decltype(predicate)::node;
-				using snode = ra::selection<pnext, node>;
+				using snode = decltype(parse_selection<pnext, node>());
 
-				return context<predicate.pos, snode>{};
+				return context<predicate.pos, decltype(restore<Pos, written, snode>())>{};
 			}
 			else
 			{
-				return context<next.pos, node>{};	
+				return context<next.pos, decltype(restore<Pos, written, node>())>{};	
 			}
 		}
 
@@ -1697,13 +6172,36 @@ namespace sql
 			}
 		}
 
-		// wrapper to determine the type for the the column
-		template <std::size_t Pos>
+		// type of the Name column in the Source rows, or in the schemas when Source lacks it
+		template <cexpr::string Name, typename Source>
+		static constexpr auto source_type()
+		{
+			if constexpr (sql::exists<Name, Source>())
+			{
+				return std::remove_cvref_t<decltype(sql::get<Name>(Source{}))>{};
+			}
+			else
+			{
+				return recurse_types<Name, Schemas...>();
+			}
+		}
+
+		// wrapper to determine the type for the the column, columns of the Source rows keep their type so outer joins project nulls
+		template <std::size_t Pos, typename Source>
 		static constexpr auto column_type()
 		{
-			constexpr cexpr::string<char, tokens_[Pos].length() + 1> name{ tokens_[Pos] };
+			constexpr cexpr::string<char, resolve<Pos, Source>().length() + 1> name{ resolve<Pos, Source>() };
 
-			return recurse_types<name, Schemas...>();
+			using type = decltype(source_type<name, Source>());
+
+			if constexpr (View)
+			{
+				return view_type<type>();
+			}
+			else
+			{
+				return type{};
+			}
 		}
 
 		// asserts token is column separator, and if comma returns one past the comma else start position
@@ -1722,14 +6220,14 @@ namespace sql
 			}
 		}
 
-		template <std::size_t Pos, bool Rename>
+		template <std::size_t Pos, bool Rename, typename Source>
 		static constexpr auto parse_colinfo()
 		{
 			static_assert(iscolumn(tokens_[Pos]), "Invalid token starting column delcaration.");
 
 			constexpr bool rename{ isas(tokens_[Pos + 1]) && iscolumn(tokens_[Pos + 2]) };
 
-			using col = decltype(column_type<Pos>());
+			using col = decltype(column_type<Pos, Source>());
 
 			if constexpr (Rename && rename)
 			{
@@ -1752,7 +6250,7 @@ namespace sql
 		}
 
 		// recursively parse all columns projected/renamed in the query
-		template <std::size_t Pos, bool Rename>
+		template <std::size_t Pos, bool Rename, typename Source>
 		static constexpr auto recurse_columns()
 		{
 			if constexpr (isfrom(tokens_[Pos]))
@@ -1761,9 +6259,9 @@ namespace sql
 			}
 			else
 			{
-				constexpr auto info{ parse_colinfo<Pos, Rename>() };
-				constexpr cexpr::string<char, tokens_[info.name].length() + 1> name{ tokens_[info.name] };
-				constexpr auto child{ recurse_columns<info.next, Rename>() };
+				constexpr auto info{ parse_colinfo<Pos, Rename, Source>() };
+				constexpr cexpr::string<char, resolve<info.name, Source>().length() + 1> name{ resolve<info.name, Source>() };
+				constexpr auto child{ recurse_columns<info.next, Rename, Source>() };
 
 				using next = std::remove_const_t<typename decltype(child)::node>;
 				using col = std::remove_const_t<decltype(sql::column<name, typename decltype(info)::type>{})>;
@@ -1773,12 +6271,26 @@ namespace sql
 			}
 		}
 
-		// wrapper to parse columns as a projection RA node
+		// position of the FROM keyword closing the column list starting at pos
+		static constexpr std::size_t find_from(std::size_t pos) noexcept
+		{
+			while (!isfrom(tokens_[pos]))
+			{
+				++pos;
+			}
+
+			return pos;
+		}
+
+		// wrapper to parse columns as a projection RA node, the input is parsed first so the columns take its types
 		template <std::size_t Pos>
 		static constexpr auto parse_projection()
 		{
-			constexpr auto proj{ recurse_columns<Pos, false>() };
-			constexpr auto next{ parse_from<proj.pos>() };
+			constexpr auto next{ parse_from<find_from(Pos)>() };
+
+			using source = std::remove_cvref_t<typename decltype(next)::node::output_type>;
+
+			constexpr auto proj{ recurse_columns<Pos, false, source>() };
 
 			using ranode = typename decltype(proj)::node;
 			using node = ra::projection<ranode, typename decltype(next)::node>;
@@ -1792,7 +6304,8 @@ namespace sql
 		{
 			constexpr auto next = parse_projection<Pos>();
 
-			using ranode = typename decltype(recurse_columns<Pos, true>())::node;
+			using source = std::remove_cvref_t<typename decltype(next)::node::output_type>;
+			using ranode = typename decltype(recurse_columns<Pos, true, source>())::node;
 			using node = ra::rename<ranode, typename decltype(next)::node>;
 
 			return context<next.pos, node>{};
@@ -1827,13 +6340,301 @@ namespace sql
 			}
 		}
 
+		// text of the tokens from first up to last as written in the query
+		static constexpr std::string_view spelling(std::size_t first, std::size_t last) noexcept
+		{
+			auto const begin{ tokens_[first].data() };
+			auto const end{ tokens_[last - 1].data() + tokens_[last - 1].size() };
+
+			return std::string_view{ begin, static_cast<std::size_t>(end - begin) };
+		}
+
+		// true when the FROM clause of the select list starting at Pos is followed by a GROUP BY clause
+		template <std::size_t Pos>
+		static constexpr bool grouped()
+		{
+			constexpr auto next{ parse_from<find_from(Pos)>() };
+
+			return next.pos + 1 < tokens_.count() && isgroup(tokens_[next.pos]) && isby(tokens_[next.pos + 1]);
+		}
+
+		// true when the select list starting at Pos calls an aggregate function, the only parentheses a select list holds
+		static constexpr bool aggregated(std::size_t pos) noexcept
+		{
+			for (; !isfrom(tokens_[pos]); ++pos)
+			{
+				if (tokens_[pos] == "(")
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// row of the Source columns named by the GROUP BY list starting at Pos
+		template <std::size_t Pos, typename Source>
+		static constexpr auto recurse_keys()
+		{
+			constexpr cexpr::string<char, resolve<Pos, Source>().length() + 1> name{ resolve<Pos, Source>() };
+
+			static_assert(sql::exists<name, Source>(), "GROUP BY column was not present in the grouped rows.");
+
+			using col = sql::column<name, std::remove_cvref_t<decltype(sql::get<name>(Source{}))>>;
+
+			if constexpr (Pos + 1 < tokens_.count() && iscomma(tokens_[Pos + 1]))
+			{
+				constexpr auto child{ recurse_keys<Pos + 2, Source>() };
+
+				return context<child.pos, sql::row<col, typename decltype(child)::node>>{};
+			}
+			else
+			{
+				return context<Pos + 1, sql::row<col, sql::void_row>>{};
+			}
+		}
+
+		// aggregate function at Pos over the Name column of the Source rows, its result may be null when a group can
+		//	hold no value of the column, which are the groups of nullable columns and the one group of a query without GROUP BY
+		template <std::size_t Pos, cexpr::string Name, typename Source, typename Keys>
+		static constexpr auto choose_aggregate()
+		{
+			using type = std::remove_cvref_t<decltype(sql::get<Name>(Source{}))>;
+
+			constexpr bool nullable{ Keys::depth == 0 || nullable_type<type>::value };
+
+			if constexpr (issum(tokens_[Pos]))
+			{
+				return sql::sum<Name, type, nullable>{};
+			}
+			else if constexpr (isavg(tokens_[Pos]))
+			{
+				return sql::avg<Name, type, nullable>{};
+			}
+			else if constexpr (ismin(tokens_[Pos]))
+			{
+				return sql::min<Name, type, nullable>{};
+			}
+			else
+			{
+				return sql::max<Name, type, nullable>{};
+			}
+		}
+
+		// parses the select list item at Pos of a grouped query into the aggregate computing it from the Source rows of a group
+		template <std::size_t Pos, typename Source, typename Keys>
+		static constexpr auto parse_aggregate()
+		{
+			if constexpr (tokens_[Pos + 1] == "(")
+			{
+				static_assert(isaggregate(tokens_[Pos]), "Aggregate functions are COUNT, SUM, AVG, MIN, and MAX.");
+				static_assert(tokens_[Pos + 3] == ")", "Expected ')' closing the aggregate function.");
+
+				constexpr cexpr::string<char, resolve<Pos + 2, Source>().length() + 1> name{ resolve<Pos + 2, Source>() };
+
+				static_assert((iscount(tokens_[Pos]) && name == "*") || sql::exists<name, Source>(), "Aggregated column was not present in the aggregated rows.");
+
+				if constexpr (iscount(tokens_[Pos]))
+				{
+					return context<Pos + 4, sql::count<name>>{};
+				}
+				else
+				{
+					return context<Pos + 4, decltype(choose_aggregate<Pos, name, Source, Keys>())>{};
+				}
+			}
+			else
+			{
+				constexpr cexpr::string<char, resolve<Pos, Keys>().length() + 1> name{ resolve<Pos, Keys>() };
+
+				static_assert(sql::exists<name, Keys>(), "Columns selected alongside aggregates must be GROUP BY columns.");
+
+				return context<Pos + 1, sql::grouped<name, std::remove_cvref_t<decltype(sql::get<name>(Keys{}))>>>{};
+			}
+		}
+
+		// recursively parses the select list of a grouped query, a column is named by its alias or else by its text as written
+		template <std::size_t Pos, typename Source, typename Keys>
+		static constexpr auto recurse_aggregates()
+		{
+			if constexpr (isfrom(tokens_[Pos]))
+			{
+				return selects<sql::void_row, std::tuple<>>{};
+			}
+			else
+			{
+				constexpr auto item{ parse_aggregate<Pos, Source, Keys>() };
+				constexpr bool rename{ isas(tokens_[item.pos]) };
+
+				static_assert(!rename || iscolumn(tokens_[item.pos + 1]), "Expected column name following 'AS' token.");
+
+				constexpr std::string_view text{ rename ? tokens_[item.pos + 1] : spelling(Pos, item.pos) };
+				constexpr cexpr::string<char, text.length() + 1> name{ text };
+
+				using aggregate = typename decltype(item)::node;
+				using col = sql::column<name, typename aggregate::type>;
+				using next = decltype(recurse_aggregates<next_column<rename ? item.pos + 2 : item.pos>(), Source, Keys>());
+				using aggregates = decltype(std::tuple_cat(std::tuple<aggregate>{}, typename next::aggregates{}));
+
+				return selects<sql::row<col, typename next::output>, aggregates>{};
+			}
+		}
+
+		// GROUP BY clause following the FROM clause ending at Pos, a query with aggregates and no GROUP BY has no keys
+		template <std::size_t Pos, typename Source>
+		static constexpr auto parse_keys()
+		{
+			if constexpr (Pos + 1 < tokens_.count() && isgroup(tokens_[Pos]) && isby(tokens_[Pos + 1]))
+			{
+				return recurse_keys<Pos + 2, Source>();
+			}
+			else
+			{
+				return context<Pos, sql::void_row>{};
+			}
+		}
+
+		// parses the select list of a query with a GROUP BY clause or aggregates into an aggregation over the rows
+		//	of its FROM clause, so only the aggregated rows leave the expression tree, rows which arrive ordered on
+		//	their one GROUP BY column are aggregated as they stream by and the rest by a hash aggregation
+		template <std::size_t Pos>
+		static constexpr auto parse_group()
+		{
+			constexpr auto next{ parse_from<find_from(Pos)>() };
+
+			using input = typename decltype(next)::node;
+			using source = std::remove_cvref_t<typename input::output_type>;
+
+			constexpr auto keys{ parse_keys<next.pos, source>() };
+
+			using row = typename decltype(keys)::node;
+			using cols = decltype(recurse_aggregates<Pos, source, row>());
+			using node = std::conditional_t<streamable<input, row>(),
+				ra::streamed<typename cols::output, row, typename cols::aggregates, input>,
+				ra::group<typename cols::output, row, typename cols::aggregates, input>>;
+
+			return context<keys.pos, node>{};
+		}
+
+		// recursively parses the ORDER BY list starting at Pos over the Row columns, an aggregate is named by its text as written
+		template <std::size_t Pos, typename Row>
+		static constexpr auto recurse_order()
+		{
+			constexpr bool call{ Pos + 1 < tokens_.count() && tokens_[Pos + 1] == "(" };
+			constexpr std::size_t next{ call ? Pos + 4 : Pos + 1 };
+			constexpr std::string_view text{ call ? spelling(Pos, next) : resolve<Pos, Row>() };
+			constexpr cexpr::string<char, text.length() + 1> name{ text };
+
+			static_assert(sql::exists<name, Row>(), "ORDER BY column was not present in the selected rows.");
+
+			constexpr bool desc{ next < tokens_.count() && isdesc(tokens_[next]) };
+			constexpr std::size_t end{ next < tokens_.count() && (desc || isasc(tokens_[next])) ? next + 1 : next };
+
+			using col = sql::direction<name, desc>;
+
+			if constexpr (end < tokens_.count() && iscomma(tokens_[end]))
+			{
+				constexpr auto child{ recurse_order<end + 1, Row>() };
+
+				return context<child.pos, decltype(prepend<col>(typename decltype(child)::node{}))>{};
+			}
+			else
+			{
+				return context<end, sql::order<col>>{};
+			}
+		}
+
+		// LIMIT clause at Pos, a query without one outputs every row
+		template <std::size_t Pos>
+		static constexpr auto parse_limit()
+		{
+			if constexpr (Pos + 1 < tokens_.count() && islimit(tokens_[Pos]))
+			{
+				static_assert(isnumber(tokens_[Pos + 1]), "Expected row count following 'LIMIT' token.");
+
+				if constexpr (Pos + 3 < tokens_.count() && isoffset(tokens_[Pos + 2]))
+				{
+					static_assert(isnumber(tokens_[Pos + 3]), "Expected row count following 'OFFSET' token.");
+
+					return bounds<Pos + 4, tocount(tokens_[Pos + 1]), tocount(tokens_[Pos + 3])>{};
+				}
+				else
+				{
+					return bounds<Pos + 2, tocount(tokens_[Pos + 1]), 0>{};
+				}
+			}
+			else
+			{
+				return bounds<Pos, ra::unlimited, 0>{};
+			}
+		}
+
+		// ORDER BY and LIMIT clauses following the select statement ending at Pos, ordered rows are sorted by a top-k node
+		//	which only keeps the rows up to the last one the LIMIT clause outputs, and a limit node stops pulling rows once
+		//	the LIMIT clause is satisfied
+		template <std::size_t Pos, typename Node>
+		static constexpr auto parse_order()
+		{
+			constexpr bool order{ Pos + 1 < tokens_.count() && isorder(tokens_[Pos]) && isby(tokens_[Pos + 1]) };
+
+			if constexpr (order)
+			{
+				using row = std::remove_cvref_t<typename Node::output_type>;
+
+				constexpr auto clause{ recurse_order<Pos + 2, row>() };
+				constexpr auto limit{ parse_limit<clause.pos>() };
+				constexpr std::size_t kept{ limit.count == ra::unlimited ? ra::unlimited : limit.count + limit.offset };
+
+				using node = ra::top<typename decltype(clause)::node, kept, Node>;
+
+				if constexpr (limit.count == 0)
+				{
+					return context<limit.pos, ra::limit<0, 0, false, Node>>{};
+				}
+				else if constexpr (limit.offset == 0)
+				{
+					return context<limit.pos, node>{};
+				}
+				else
+				{
+					return context<limit.pos, ra::limit<limit.count, limit.offset, true, node>>{};
+				}
+			}
+			else
+			{
+				constexpr auto limit{ parse_limit<Pos>() };
+
+				if constexpr (limit.count == ra::unlimited)
+				{
+					return context<Pos, Node>{};
+				}
+				else
+				{
+					return context<limit.pos, ra::limit<limit.count, limit.offset, skippable<Node>::value, Node>>{};
+				}
+			}
+		}
+
 		// decide RA node to root the expression tree
 		template <std::size_t Pos>
 		static constexpr auto parse_root()
+		{
+			constexpr auto next{ parse_select<Pos>() };
+
+			return parse_order<next.pos, typename decltype(next)::node>();
+		}
+
+		// decide RA node to compute the rows of the select statement at Pos
+		template <std::size_t Pos>
+		static constexpr auto parse_select()
 		{
 			static_assert(isselect(tokens_[Pos]), "Expected 'SELECT' token not found.");
 
-			if constexpr (tokens_[Pos + 1] == "*")
+			if constexpr (grouped<Pos + 1>() || aggregated(Pos + 1))
+			{
+				return parse_group<Pos + 1>();
+			}
+			else if constexpr (tokens_[Pos + 1] == "*")
 			{
 				return parse_from<Pos + 2>();
 			}
@@ -1851,40 +6652,146 @@ namespace sql
 
 		using expression = typename decltype(parse_root<0>())::node;
 
-		bool empty_;
-	
-	public:
-		using iterator = query_iterator<expression>;
-		using row_type = expression::output_type;
-
-		query(Schemas const&... tables)
+		// views are only valid while the rows they refer to stay in place
+		static constexpr bool viewable()
 		{
-			try 
+			if constexpr (scan<expression>::value)
 			{
-				expression::seed(tables...);
-				empty_ = false;
+				return !scan<expression>::schema::columnar;
 			}
-			catch(ra::data_end const& e)
+			else
 			{
-				empty_ = true;
+				return false;
 			}
 		}
 
-		~query()
+		static_assert(!View || viewable(), "View queries are limited to SELECT ... FROM ... WHERE over one row wise schema.");
+	
+	public:
+		using iterator = query_iterator<expression>;
+		using row_type = expression::output_type;
+
+		basic_query(Schemas const&... tables)
 		{
-			expression::reset();
+			expr_.seed(tables...);
 		}
 
+		// a seeded expression tree points into its own nodes, like the right rows a merge join grouped or a cross
+		//	join buffered, so a copy would point into the query it was copied from, queries are neither copied nor moved
+		basic_query(basic_query const&) = delete;
+
+		basic_query& operator=(basic_query const&) = delete;
+
 		inline iterator begin() const
 		{
-			return iterator{ empty_ };
+			return iterator{ &expr_ };
 		}
 
 		inline iterator end() const
 		{
-			return iterator{ true };
+			return iterator{ nullptr };
+		}
+
+		// streams the query output in batches of up to Size rows
+		template <std::size_t Size = 1024>
+		inline batch_range<expression, Size> batches() const
+		{
+			return batch_range<expression, Size>{ &expr_ };
+		}
+
+		// runs a single schema query over chunks of the table on the given number of threads
+		static std::vector<row_type> parallel(Schemas const&... tables, std::size_t threads = 0, merge order = merge::ordered)
+		{
+			static_assert(sizeof...(Schemas) == 1, "Parallel queries operate on a single schema.");
+			static_assert(scan<expression>::value, "Parallel queries are limited to SELECT ... FROM ... WHERE over one schema.");
+
+			using schema_type = std::remove_cvref_t<decltype((tables, ...))>;
+			using const_iterator = typename schema_type::const_iterator;
+			constexpr std::size_t batch_size{ 1024 };
+
+			auto const& table{ (tables, ...) };
+			std::size_t const size = std::distance(table.begin(), table.end());
+
+			if (threads == 0)
+			{
+				threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+			}
+
+			// several chunks per thread so faster threads pick up the slack
+			auto const step{ std::max<std::size_t>(size / (threads * 4), batch_size) };
+			std::vector<const_iterator> bounds{ table.begin() };
+
+			for (std::size_t pos{ step }; pos < size; pos += step)
+			{
+				bounds.push_back(std::next(bounds.back(), step));
+			}
+
+			bounds.push_back(table.end());
+
+			auto const chunks{ bounds.size() - 1 };
+			std::vector<std::vector<row_type>> outputs(order == merge::ordered ? chunks : threads);
+			std::atomic<std::size_t> claimed{};
+
+			auto work = [&](std::size_t id)
+			{
+				expression expr{};
+				std::vector<row_type const*> rows(batch_size);
+
+				for (auto chunk{ claimed++ }; chunk < chunks; chunk = claimed++)
+				{
+					auto& output{ outputs[order == merge::ordered ? chunk : id] };
+					expr.seed(ra::slice<schema_type>{ bounds[chunk], bounds[chunk + 1] });
+
+					for (auto count{ expr.next_batch(std::span{ rows }) }; count != 0; count = expr.next_batch(std::span{ rows }))
+					{
+						for (std::size_t i{}; i < count; ++i)
+						{
+							output.push_back(*rows[i]);
+						}
+					}
+				}
+			};
+
+			{
+				std::vector<std::jthread> workers{};
+
+				for (std::size_t id{ 1 }; id < threads; ++id)
+				{
+					workers.emplace_back(work, id);
+				}
+
+				work(0);
+			}
+
+			std::size_t total{};
+
+			for (auto const& output : outputs)
+			{
+				total += output.size();
+			}
+
+			std::vector<row_type> result{};
+			result.reserve(total);
+
+			for (auto& output : outputs)
+			{
+				std::move(output.begin(), output.end(), std::back_inserter(result));
+			}
+
+			return result;
 		}
+
+	private:
+		// the expression tree holds all cursor and row state for this object
+		mutable expression expr_{};
 	};
 
+	template <cexpr::string Str, typename... Schemas>
+	using query = basic_query<Str, false, Schemas...>;
+
+	// query whose std::string columns are output as std::string_view into the schema storage
+	template <cexpr::string Str, typename... Schemas>
+	using query_view = basic_query<Str, true, Schemas...>;
+
 } // namespace sql
 
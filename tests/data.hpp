@@ -1,16 +1,52 @@
 #pragma once
 
+#include <optional>
+#include <ostream>
 #include <string>
 #include <type_traits>
 
 #include "sql.hpp"
 
+// null columns of outer joins print as empty fields like sqlite's nulls
+template <typename Type>
+std::ostream& operator<<(std::ostream& os, std::optional<Type> const& val)
+{
+	if (val)
+	{
+		os << *val;
+	}
+
+	return os;
+}
+
+// storage of each schema, Key is its leading column which sorted schemas are indexed on
+#if defined(COLUMNAR)
+template <cexpr::string Key>
+using storage = sql::columnar;
+#elif defined(SORTED) || defined(MIXED)
+template <cexpr::string Key>
+using storage = sql::index<Key>;
+#else
+template <cexpr::string Key>
+using storage = sql::index<>;
+#endif
+
+// storage of the schemas only joined from the right, mixed runs leave them unindexed so joins hash an indexed scan with an unindexed one
+#if defined(MIXED)
+template <cexpr::string Key>
+using joined_storage = sql::index<>;
+#else
+template <cexpr::string Key>
+using joined_storage = storage<Key>;
+#endif
+
 using books =
 	sql::schema<
-		"books", sql::index<>,
-#ifdef CROSS
+#if defined(CROSS) || defined(INNER) || defined(OUTER)
+		"books", storage<"book">,
 		sql::column<"book", std::string>,
 #else
+		"books", storage<"title">,
 		sql::column<"title", std::string>,
 #endif
 		sql::column<"genre", std::string>,
@@ -20,10 +56,11 @@ using books =
 
 using stories =
 	sql::schema<
-		"stories", sql::index<>,
-#ifdef CROSS
+#if defined(CROSS) || defined(INNER) || defined(OUTER)
+		"stories", storage<"story">,
 		sql::column<"story", std::string>,
 #else
+		"stories", storage<"title">,
 		sql::column<"title", std::string>,
 #endif
 		sql::column<"genre", std::string>,
@@ -32,19 +69,32 @@ using stories =
 
 using authored =
 	sql::schema<
-		"authored", sql::index<>,
+		"authored", joined_storage<"title">,
 		sql::column<"title", std::string>,
 		sql::column<"name", std::string>
 	>;
 
 using collected =
 	sql::schema<
-		"collected", sql::index<>,
+		"collected", joined_storage<"title">,
 		sql::column<"title", std::string>,
 		sql::column<"collection", std::string>,
 		sql::column<"pages", unsigned>
 	>;
 
+// row counts of the data files, chains of joins join the smaller tables first
+template <>
+inline constexpr std::size_t sql::cardinality<books>{ 332 };
+
+template <>
+inline constexpr std::size_t sql::cardinality<stories>{ 715 };
+
+template <>
+inline constexpr std::size_t sql::cardinality<authored>{ 1057 };
+
+template <>
+inline constexpr std::size_t sql::cardinality<collected>{ 751 };
+
 const std::string data_folder{ "./data/" };
 const std::string perf_folder{ "../data/" };
 const std::string books_data{ "books.tsv" };
@@ -63,6 +113,7 @@ using collected_type = std::vector<collected_row>;
 
 constexpr std::size_t iters{ 65536 };
 constexpr std::size_t offset{ 512 };
+constexpr std::size_t scale{ 1024 };
 
 template <char Delim>
 books_type books_load()
@@ -123,7 +174,7 @@ authored_type authored_load()
 	{
 		authored_row row{};
 		std::getline(file, std::get<0>(row), Delim);
-		std::getline(file, std::get<1>(row), Delim);
+		std::getline(file, std::get<1>(row));
 		
 		table.push_back(std::move(row));
 
@@ -3,7 +3,7 @@
 
 using query =
 	sql::query<
-		"SELECT book, genre AS type, year As published "
+		"SELECT book, genre AS type, year AS published "
 		"FROM books CROSS JOIN authored "
 		"WHERE NOT genre != \"science fiction\" AND year > 1970",
 		books,
@@ -12,7 +12,7 @@ using query =
 
 int main()
 {
-	books b{ sql::load<books,>(perf_folder + books_data '\t') };
+	books b{ sql::load<books>(perf_folder + books_data, '\t') };
 	authored a{ sql::load<authored>(perf_folder + authored_data, '\t') };
 
 	for (std::size_t i{}; i < iters / offset; ++i)
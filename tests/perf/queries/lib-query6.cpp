@@ -0,0 +1,50 @@
+#include <iostream>
+#include <string>
+
+#include "../../data.hpp"
+
+using query =
+	sql::query<
+		"SELECT title, genre, year, name "
+		"FROM stories NATURAL JOIN authored",
+		stories,
+		authored
+	>;
+
+int main()
+{
+	stories const s_data{ sql::load<stories>(perf_folder + stories_data, '\t') };
+	authored const a_data{ sql::load<authored>(perf_folder + authored_data, '\t') };
+	stories s{};
+	authored a{};
+
+	// copies of the tables with distinct titles scale the join up to millions of rows
+	for (std::size_t i{}; i < scale; ++i)
+	{
+		auto const suffix{ '#' + std::to_string(i) };
+
+		for (auto const& [t, g, y] : s_data)
+		{
+			s.emplace(t + suffix, g, y);
+		}
+
+		for (auto const& [t, n] : a_data)
+		{
+			a.emplace(t + suffix, n);
+		}
+	}
+
+	std::size_t count{};
+
+	for (std::size_t i{}; i < 8; ++i)
+	{
+		for (query q{ s, a }; auto const& [t, g, y, n] : q)
+		{
+			count += y;
+		}
+	}
+
+	std::cout << count << '\n';
+
+	return 0;
+}
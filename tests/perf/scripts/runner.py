@@ -1,9 +1,9 @@
 import os
 
-QUERIES = 6
+QUERIES = 7
 
 def exe(file, q):
-	if int(q) >= 4:
+	if int(q) in (4, 5):
 		os.system("g++ -std=c++2a -DCROSS -O3 -I../../single-header -o test queries/" + file)
 	else:
 		os.system("g++ -std=c++2a -O3 -I../../single-header -o test queries/" + file)
@@ -1,3 +1,3 @@
 mkdir queries
 python3 scripts/generate.py
-python3 scripts/runner.py
+python3 scripts/runner.py "$@"
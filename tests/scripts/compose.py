@@ -4,8 +4,13 @@ begin = """#include <iostream>
 
 #include "data.hpp"
 
+#if defined(VIEW) && defined(JOINLESS)
+using query =
+	sql::query_view<
+#else
 using query =
 	sql::query<
+#endif
 """
 middle = """
 	>;
@@ -19,19 +24,20 @@ end = """
 """
 
 def data(tokens):
-	f = False
 	cs = 1
 	ts = []
-	for tk in tokens:
+	listed = True
+	for i, tk in enumerate(tokens):
 		tk = tk.lower()
-		if tk[-1] == ",":
-			cs += 1
-		if tk == "where":
-			break
 		if tk == "from":
-			f = True
-		elif f and tk != "cross" and tk != "natural" and tk != "join":
-			ts += [tk]
+			listed = False
+		if listed and tk[-1] == ",":
+			cs += 1
+		# a subquery's own FROM names its tables
+		if (tk == "from" or tk == "join") and tokens[i + 1][0] != "(":
+			t = tokens[i + 1].lower().rstrip(")")
+			if not t in ts:
+				ts += [t]
 	return cs, ts
 
 def templ(query, ts):
@@ -42,18 +48,20 @@ def templ(query, ts):
 
 def func(ts, cs):
 	body = ""
-	args = ""
-	out = "\tstd::cout << "
-	count = 0
-	for t in ts:
-		body += "\t" + t + " t" + str(count) + "{ sql::load<" + t + ">(data_folder + " + t + "_data, '\\t') };\n"
-		args += "t" + str(count) + ", "
-		count += 1
-	body += "\n\tfor (query q{ " + args[:-2] + " }; auto const& ["
-	for c in range(cs):
-		body += "c" + str(c) + ", "
-		out += "c" + str(c) + " << \'|\' << "
-	body = body[:-2] + "] : q)\n\t{\n\t" + out[:-11] + " << \'\\n\';\n\t}\n"
+	args = ", ".join("t" + str(i) for i in range(len(ts)))
+	cols = ", ".join("c" + str(c) for c in range(cs))
+	out = "std::cout << " + " << \'|\' << ".join("c" + str(c) for c in range(cs)) + " << \'\\n\';"
+	for i, t in enumerate(ts):
+		body += "\t" + t + " t" + str(i) + "{ sql::load<" + t + ">(data_folder + " + t + "_data, '\\t') };\n"
+	# the runner's flags read the rows in batches of 7, or split the scan of a joinless query over 4 threads
+	body += "\n#if defined(BATCHES)\n"
+	body += "\tfor (query q{ " + args + " }; auto const& rows : q.batches<7>())\n\t{\n"
+	body += "\t\tfor (auto const& [" + cols + "] : rows)\n\t\t{\n\t\t\t" + out + "\n\t\t}\n\t}\n"
+	body += "#elif defined(PARALLEL) && defined(JOINLESS)\n"
+	body += "\tfor (auto const& [" + cols + "] : query::parallel(" + args + ", 4, sql::merge::unordered))\n\t{\n\t\t" + out + "\n\t}\n"
+	body += "#else\n"
+	body += "\tfor (query q{ " + args + " }; auto const& [" + cols + "] : q)\n\t{\n\t\t" + out + "\n\t}\n"
+	body += "#endif\n"
 	return body
 
 def main():
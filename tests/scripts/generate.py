@@ -17,12 +17,18 @@ joinable = {
 	"authored": [],
 	"collected": []
 }
-joins = ["cross"]
+# tables joined by a chain of inner joins, data.hpp's row counts make the parser join them in another order
+chains = [["authored", "collected", "stories"]]
+joins = ["cross", "inner", "outer"]
+outers = ["left", "right", "full"]
 renames = {
 	"genre": "type",
 	"year": "published"
 }
 integral = ["year", "pages"]
+aggregates = ["count(*)", "count(*) as total"]
+# avg is left out, sqlite prints its doubles with another precision
+folds = ["sum", "min", "max"]
 all_comp = ["=", "!=", "<>"]
 integral_comp = [">", "<", ">=", "<="]
 bool_op = ["or", "and"]
@@ -35,7 +41,9 @@ where_data = {
 }
 outfiles = { 
 	"joinless": open("queries/joinless-queries.txt", "w"),
-	"cross": open("queries/cross-queries.txt", "w") 
+	"cross": open("queries/cross-queries.txt", "w"),
+	"inner": open("queries/inner-queries.txt", "w"),
+	"outer": open("queries/outer-queries.txt", "w")
 }
 
 def col_list(cs):
@@ -57,27 +65,64 @@ def col_list(cs):
 		cl += [cols[:-2]]
 	return cl
 
+# joins the leading column of each table, sometimes qualified with the table name
+def on(ts, qualify=False):
+	l, r = columns[ts[0]][0], columns[ts[1]][0]
+	if qualify or random.random() < 0.5:
+		l, r = ts[0] + "." + l, ts[1] + "." + r
+	if random.random() < 0.5:
+		l, r = r, l
+	return " on " + l + " = " + r
+
+# equates the leading columns of a cross join's tables in its where clause, which the parser turns into an equi join
+def equate(ts):
+	l, r = columns[ts[0]][0], columns[ts[1]][0]
+	if l == r or random.random() < 0.5:
+		return ""
+	if random.random() < 0.5:
+		l, r = r, l
+	return l + " = " + r
+
+def where(pred, cond):
+	if cond != "" and pred != "":
+		return " where " + cond + " and (" + pred + ")"
+	elif cond != "" or pred != "":
+		return " where " + cond + pred
+	else:
+		return ""
+
 def froms(ts):
 	f = []
-	output = outfiles["joinless"]
 	if len(ts) == 1:
-		f = [ts[0]]
+		f = [(ts[0], outfiles["joinless"], "")]
+	elif len(ts) == 3:
+		# the second join equates the leading columns of the last two tables, which share a name so every column is qualified
+		f = [(ts[0] + " join " + ts[1] + on(ts, True) + " join " + ts[2] + on(ts[1:], True), outfiles["inner"], "")]
 	else:
 		for j in joins:
 			output = outfiles[j]
 			if random.random() < 0.3333:
 				j = j.upper()
-			f += [ts[0] + " " + j + " join " + ts[1]]
-	return f, output
+			if j.lower() == "inner":
+				f += [(ts[0] + " join " + ts[1] + on(ts), output, "")]
+			elif j.lower() == "outer":
+				kind = random.choice(outers)
+				if random.random() < 0.5:
+					kind += " outer"
+				if random.random() < 0.3333:
+					kind = kind.upper()
+				f += [(ts[0] + " " + kind + " join " + ts[1] + on(ts), output, "")]
+			elif j.lower() == "cross":
+				f += [(ts[0] + " " + j + " join " + ts[1], output, equate(ts))]
+			else:
+				f += [(ts[0] + " " + j + " join " + ts[1], output, "")]
+	return f
 
 def compose(ts, cs, pred):
-	if pred != "":
-		pred = " where " + pred
 	cols = col_list(cs)
-	sel, output = froms(ts)
-	for s in sel:
+	for s, output, cond in froms(ts):
 		for c in cols:
-			output.write("select " + c + " from " + s + pred + "\n")
+			output.write("select " + c + " from " + s + where(pred, cond) + "\n")
 
 def next(cs, ci):
 	if ci >= len(cs):
@@ -123,6 +168,9 @@ def select(ts):
 	cols = []
 	for t in ts:
 		cols += columns[t]
+	if len(ts) > 2:
+		# columns of several tables are ambiguous in a chain of joins
+		cols = [c for c in cols if cols.count(c) == 1]
 	for i in range(len(cols)):
 		comb = list(itertools.combinations(cols, i + 1))
 		for cs in comb:
@@ -132,16 +180,107 @@ def select(ts):
 			else:
 				pred = operation(ts, cs, ci, "")
 
+# groups the rows of the tables on combinations of their columns besides the joined leading ones
+def grouped(ts):
+	keys = []
+	for t in ts:
+		keys += [c for c in columns[t][1:] if not c in keys]
+	for i in range(min(len(keys), 2)):
+		for ks in itertools.combinations(keys, i + 1):
+			g = ", ".join(ks)
+			for agg in aggregates + [f + "(" + c + ")" for f in folds for c in integral if c in keys and not c in ks]:
+				for pred in ["", " where year > 1970"]:
+					if pred != "" and not "year" in keys:
+						continue
+					a, gb = agg, " group by "
+					if random.random() < 0.3333:
+						a, gb = a[:a.index("(")].upper() + a[a.index("("):], gb.upper()
+					outfiles["grouped"].write("select " + g + ", " + a + " from " + " natural join ".join(ts) + pred + gb + g + "\n")
+	if len(ts) == 1:
+		# the leading column, run with "sorted" its groups stream out of the schema's index
+		lead = columns[ts[0]][0]
+		for agg in aggregates + [f + "(" + c + ")" for f in folds for c in integral if c in keys]:
+			outfiles["grouped"].write("select " + lead + ", " + agg + " from " + ts[0] + " group by " + lead + "\n")
+	scalars = aggregates + [f + "(" + c + ")" for f in folds for c in integral if c in keys]
+	for agg in scalars + [", ".join(scalars)]:
+		for pred in ["", " where year > 1970"]:
+			if pred != "" and not "year" in keys:
+				continue
+			outfiles["grouped"].write("select " + agg + " from " + " natural join ".join(ts) + pred + "\n")
+
+# sorts the rows on every selected column so the rows kept by a LIMIT are the same as sqlite's
+def ordered(ts):
+	cols = []
+	for t in ts:
+		cols += [c for c in columns[t] if not c in cols]
+	for limit in ["", " limit 0", " limit 1", " limit 20"]:
+		for pred in ["", " where year > 1970"]:
+			if pred != "" and not "year" in cols:
+				continue
+			keys = random.sample(cols, len(cols))
+			order = ", ".join(k + random.choice(["", " asc", " desc"]) for k in keys)
+			ob = " order by "
+			if random.random() < 0.3333:
+				ob, limit = ob.upper(), limit.upper()
+			outfiles["ordered"].write("select " + ", ".join(cols) + " from " + " natural join ".join(ts) + pred + ob + order + limit + "\n")
+			if limit != "":
+				offset = " offset 5"
+				if random.random() < 0.3333:
+					offset = offset.upper()
+				outfiles["ordered"].write("select " + ", ".join(cols) + " from " + " natural join ".join(ts) + pred + ob + order + limit + offset + "\n")
+	# without ORDER BY the rows kept depend on the scan order, unless the limit keeps none or all of them
+	for limit in [" limit 0", " limit 100000 offset 0"]:
+		outfiles["ordered"].write("select " + ", ".join(cols) + " from " + " natural join ".join(ts) + limit + "\n")
+	if len(ts) == 1:
+		for k in columns[ts[0]][1:]:
+			outfiles["ordered"].write("select " + k + ", count(*) from " + ts[0] + " group by " + k + " order by count(*) desc, " + k + " limit 5\n")
+
+# subqueries renaming a column to the name of the column their schema is indexed on, run with "sorted" the renamed column is not ordered
+def renamed():
+	outfiles["grouped"].write("select title, count(*) from (select genre as title, year from books) group by title\n")
+	outfiles["natural"].write("select title, pages, name from (select collection as title, pages from collected) natural join authored\n")
+	outfiles["natural"].write("select title, name, pages from authored natural join (select collection as title, pages from collected)\n")
+
+# chains of outer joins whose second ON clause is keyed on a column the first join may pad with nulls, which match no row
+def outer_chains():
+	for first in outers + ["inner"]:
+		for second in outers + ["inner"]:
+			outfiles["outer"].write("select book, name, collection from books " + first + " join authored on book = authored.title " + second + " join collected on authored.title = collected.title\n")
+
+# joins keyed on columns of the same name, the right one is kept beside the left one under its qualified name
+def shared_keys():
+	for kind in outers + ["inner"]:
+		outfiles["outer"].write("select authored.title, collected.title, name, collection from authored " + kind + " join collected on authored.title = collected.title\n")
+	for pred in ["", " and pages > 300"]:
+		outfiles["cross"].write("select authored.title, collected.title, name, collection from authored cross join collected where authored.title = collected.title" + pred + "\n")
+
 def root_query(left):
 	select([left])
 	for right in joinable[left]:
 		select([left, right])
+	if "grouped" in outfiles:
+		grouped([left])
+		for right in joinable[left]:
+			grouped([left, right])
+	if "ordered" in outfiles:
+		ordered([left])
+		for right in joinable[left]:
+			ordered([left, right])
+	if "inner" in joins:
+		for chain in chains:
+			if chain[0] == left:
+				select(chain)
 
 def main():
 	print("Test Generator")
 	for table in tables:
 		print("\tGenerating queries for \"" + table + "\" schema")
 		root_query(table)
+	if "outer" in outfiles:
+		outer_chains()
+		shared_keys()
+	if "grouped" in outfiles:
+		renamed()
 
 if __name__ == "__main__":
 	main()
@@ -150,7 +289,9 @@ if __name__ == "__main__":
 	joins = ["natural"]
 	outfiles = {
 		"joinless": open("queries/joinless-queries.txt", "w"),
-		"natural": open("queries/natural-queries.txt", "w")
+		"natural": open("queries/natural-queries.txt", "w"),
+		"grouped": open("queries/grouped-queries.txt", "w"),
+		"ordered": open("queries/ordered-queries.txt", "w")
 	}
 	columns = {
 		"books": ["title", "genre", "year", "pages"],
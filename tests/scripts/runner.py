@@ -1,4 +1,5 @@
 import os
+import sys
 
 def main():
 	print("Test Runner")
@@ -7,19 +8,24 @@ def main():
 	num = 1
 	token = ""
 	db = "library.db"
+	# extra macros for the data header, e.g. "columnar" stores every schema column wise and
+	# "sorted" indexes every schema on its leading column, "mixed" only the schemas joined from the left,
+	# and for the composed test, "batches" reads the rows in batches, "parallel" scans joinless queries
+	# on several threads, and "view" outputs the strings of joinless queries as views into the schemas
+	flags = "".join(" -D" + arg.upper() for arg in sys.argv[1:])
 	with open("queries/test-queries.txt", "r") as queries:
 		for query in queries:
 			query = query.strip()
 			if query[0] != "s":
 				token = query
-				if query == "CROSS":
+				if query == "CROSS" or query == "INNER" or query == "OUTER":
 					db = "library-cross.db"
 				continue
 			q = open("queries/query", "w")
 			q.write(query + "\n")
 			q.close()
 			os.system("python3 scripts/compose.py")
-			os.system("g++ -std=c++2a " + "-D" + token + " -O3 -I../single-header -o test test.cpp")
+			os.system("g++ -std=c++2a " + "-D" + token + flags + " -O3 -I../single-header -o test test.cpp")
 			os.system("./test | sort > cpp-results.txt")
 			os.system("sqlite3 data/" + db + " \"" + query + ";\" | sort > sql-results.txt")
 			stream = os.popen("diff cpp-results.txt sql-results.txt")
@@ -18,11 +18,31 @@ def main():
 		for line in infile:
 			if random.random() < h:
 				outfile.write(line)
+	outfile.write("GROUPED\n")
+	with open("queries/grouped-queries.txt", "r") as infile:
+		for line in infile:
+			if random.random() < h:
+				outfile.write(line)
+	outfile.write("ORDERED\n")
+	with open("queries/ordered-queries.txt", "r") as infile:
+		for line in infile:
+			if random.random() < h:
+				outfile.write(line)
 	outfile.write("CROSS\n")
 	with open("queries/cross-queries.txt", "r") as infile:
 		for line in infile:
 			if random.random() < h:
 				outfile.write(line)
+	outfile.write("INNER\n")
+	with open("queries/inner-queries.txt", "r") as infile:
+		for line in infile:
+			if random.random() < h:
+				outfile.write(line)
+	outfile.write("OUTER\n")
+	with open("queries/outer-queries.txt", "r") as infile:
+		for line in infile:
+			if random.random() < h:
+				outfile.write(line)
 	outfile.close()
 
 if __name__ == "__main__":